@@ -0,0 +1,133 @@
+#ifndef ADMISSION_CONTROLLER_H
+#define ADMISSION_CONTROLLER_H
+
+#include "RegistrationSystem.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+struct AdmissionPolicy {
+    size_t maxQueuedPerCourse = 64;    // Requests waiting on one course
+    size_t maxPendingPerStudent = 2;   // Requests one student may have waiting or running
+    size_t maxQueued = 1024;           // Requests waiting across all courses
+    size_t workers = 1;                // Dispatcher threads (requests still run one at a time on the engine)
+};
+
+struct AdmissionMetrics {
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t rejectedQueueFull = 0;     // Course queue or total limit reached
+    uint64_t rejectedStudentLimit = 0;  // Student already at maxPendingPerStudent
+    size_t queued = 0;                  // Waiting right now
+    size_t maxQueued = 0;               // High-water mark
+    size_t activeCourses = 0;           // Courses with a non-empty queue
+    std::vector<std::pair<CourseCode, size_t>> deepestQueues;   // Up to five, deepest first
+    double meanWaitMs = 0.0;            // Time from submit to start of processing
+    double p99WaitMs = 0.0;             // Upper bound of the 99th percentile bucket
+    double maxWaitMs = 0.0;
+    double meanServiceUs = 0.0;         // Recent average processing time per request
+
+    void print(std::ostream& out) const;
+};
+
+// Admission layer in front of the registration engine for registration
+// surges. Requests from any thread are queued per course and the dispatcher
+// threads feed them to the engine, taking one request from each busy course
+// in turn so a hot course cannot starve the others; a course's requests run
+// in order, one at a time. Each student may have only a few requests
+// outstanding, so one client cannot flood a queue. When a queue is full the
+// request is answered at once with TryLater and an estimated wait instead of
+// being queued.
+//
+// The engine is single-writer: each request runs while holding engineLock,
+// the lock every other writer of the RegistrationSystem takes too (see
+// SessionExecutor::engineLock()). Submitting never takes it, so a caller
+// that holds it may submit and then release it while waiting.
+class AdmissionController {
+private:
+    enum class Kind { Register, Drop, Swap };
+
+    struct Request {
+        Kind kind;
+        Student* student;
+        StudentId studentID;
+        std::string courseCode;   // Swap: the course being dropped
+        std::string toCode;       // Swap only
+        std::string sectionID;
+        std::chrono::steady_clock::time_point submitted;
+        std::promise<RegistrationResult> promise;
+        std::function<void()> onReady;
+    };
+
+    static const size_t WAIT_BUCKETS = 32;   // Bucket b holds waits below 2^b microseconds
+
+    RegistrationSystem& regSys;
+    std::mutex& engineLock;
+    AdmissionPolicy policy;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::unordered_map<CourseCode, std::deque<Request>> queues;
+    std::deque<CourseCode> rotation;                 // Courses with waiting requests, next first
+    std::unordered_set<CourseCode> running;          // Out of the rotation until their request ends
+    std::unordered_map<StudentId, size_t> pending;   // Waiting or running, per student
+    size_t queued;
+    bool stopping;
+
+    // Metrics, guarded by mutex
+    AdmissionMetrics counters;
+    double waitTotalMs;
+    uint64_t waitHistogram[WAIT_BUCKETS];
+    double serviceAverageUs;
+
+    std::vector<std::thread> dispatchers;
+
+    std::future<RegistrationResult> submit(Kind kind, Student& student, const std::string& queueCode,
+                                           const std::string& courseCode, const std::string& toCode,
+                                           const std::string& sectionID, std::function<void()> onReady);
+    // Caller holds mutex
+    uint32_t estimatedWaitMs() const;
+    void dispatch();
+    RegistrationResult execute(Request& request);
+
+public:
+    // Starts policy.workers dispatcher threads
+    AdmissionController(RegistrationSystem& regSys, std::mutex& engineLock,
+                        const AdmissionPolicy& policy = AdmissionPolicy());
+    // Finishes every admitted request, then stops
+    ~AdmissionController();
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    // Thread-safe. The future is ready at once if the request is not admitted
+    // (TryLater with retryAfterMs) or the course code is malformed. onReady,
+    // if given, is called once the future is ready: on the calling thread
+    // when it is ready at once, on a dispatcher thread otherwise.
+    std::future<RegistrationResult> submitRegister(Student& student, const std::string& courseCode,
+                                                   const std::string& sectionID = "",
+                                                   std::function<void()> onReady = nullptr);
+    std::future<RegistrationResult> submitDrop(Student& student, const std::string& courseCode,
+                                               std::function<void()> onReady = nullptr);
+    // Queued on the course being joined
+    std::future<RegistrationResult> submitSwap(Student& student, const std::string& fromCode,
+                                               const std::string& toCode, const std::string& toSectionID = "",
+                                               std::function<void()> onReady = nullptr);
+
+    // Stops admitting (later requests get TryLater) and waits for the queues to drain
+    void shutdown();
+
+    AdmissionMetrics metrics();
+};
+
+#endif // ADMISSION_CONTROLLER_H
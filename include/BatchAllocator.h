@@ -0,0 +1,79 @@
+#ifndef BATCH_ALLOCATOR_H
+#define BATCH_ALLOCATOR_H
+
+#include "Course.h"
+#include "Student.h"
+#include "RuleSet.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// How students are ordered when seats are contested
+enum class PriorityPolicy {
+    GPA,            // Higher GPA first
+    ClassYear,      // Earlier cohort first (lower student ID number)
+    LotteryOnly     // Pure random order
+};
+
+struct AllocationPolicy {
+    PriorityPolicy priority = PriorityPolicy::GPA;
+    uint64_t seed = 1;       // Seed for the random tiebreak
+    unsigned threads = 0;    // 0 = hardware concurrency
+};
+
+// One choice in a request: a course and optionally a specific section
+struct SeatChoice {
+    std::string courseCode;
+    std::string sectionID;   // Empty = any section
+};
+
+// A request for one seat; alternates are tried in order if earlier choices fail
+struct SeatRequest {
+    std::string studentID;
+    std::vector<SeatChoice> rankedChoices;
+};
+
+// Result for a single request
+struct AllocationOutcome {
+    std::string studentID;
+    std::string assignedCourse;  // Empty if unplaced
+    std::string sectionID;
+    int choiceRank;              // 0 = first choice, -1 if unplaced
+    std::string reason;          // Why the last choice failed, if unplaced
+};
+
+struct AllocationReport {
+    std::vector<AllocationOutcome> outcomes;  // Sorted by student ID
+    size_t admitted = 0;
+    size_t firstChoice = 0;
+    size_t unplaced = 0;
+
+    void print(std::ostream& out) const;
+};
+
+// Resolves a window's worth of seat requests in one batch.
+//
+// Students are ranked once by the policy plus a seeded lottery number.
+// Allocation then runs in passes like a draft: in each pass every student
+// offers their next pending request, candidates are grouped by course with
+// a single sort, and courses are resolved in parallel. Since a student has
+// at most one candidate per pass, no student state is shared between threads.
+// Registration rules, if given, are checked per candidate section with the
+// student's load as allocated so far.
+class BatchAllocator {
+private:
+    CourseStore& courseStore;
+    StudentStore& studentStore;
+    AllocationPolicy policy;
+    const RuleSet* rules;
+
+public:
+    BatchAllocator(CourseStore& courses, StudentStore& students, const AllocationPolicy& policy,
+                   const RuleSet* rules = nullptr);
+
+    // Allocates seats, applies them to the courses and students, and reports per request
+    AllocationReport run(const std::vector<SeatRequest>& requests);
+};
+
+#endif // BATCH_ALLOCATOR_H
@@ -0,0 +1,153 @@
+#ifndef CATALOG_SNAPSHOT_H
+#define CATALOG_SNAPSHOT_H
+
+#include "Course.h"
+#include "Keys.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// One immutable version of the catalog. Courses are shared between versions:
+// a version that changes one course copies that course, the chunk holding it
+// and the chunk list, and shares everything else with the version before it.
+class CatalogSnapshot {
+public:
+    static const size_t CHUNK_SIZE = 32;
+    struct Entry {
+        std::shared_ptr<const Course> course;
+        uint64_t changedIn;   // Version that last placed this course
+    };
+    typedef std::vector<Entry> Chunk;
+    typedef std::unordered_map<CourseCode, uint32_t> Index;   // Code -> position
+
+private:
+    std::vector<std::shared_ptr<const Chunk>> chunks;
+    std::shared_ptr<const Index> index = std::make_shared<const Index>();
+    size_t count = 0;
+    uint64_t version = 0;
+
+    const Entry& entry(size_t position) const { return (*chunks[position / CHUNK_SIZE])[position % CHUNK_SIZE]; }
+    friend class SnapshotPublisher;
+
+public:
+    uint64_t getVersion() const { return version; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Course& at(size_t position) const { return *entry(position).course; }
+    // Equal for two versions only if the course at position did not change
+    // in between; lets readers cache what they derive from a course
+    uint64_t changedIn(size_t position) const { return entry(position).changedIn; }
+    // nullptr if the code is not in this version
+    const Course* find(std::string_view code) const;
+};
+
+class SnapshotPublisher;
+
+// A pinned snapshot. While it is held the snapshot is not reclaimed, however
+// many newer versions are published; release it promptly (it is move-only
+// and releases on destruction).
+class CatalogReader {
+private:
+    std::atomic<uint64_t>* slot;
+    const CatalogSnapshot* snapshot;
+
+    CatalogReader(std::atomic<uint64_t>* slot, const CatalogSnapshot* snapshot) : slot(slot), snapshot(snapshot) {}
+    friend class SnapshotPublisher;
+
+public:
+    CatalogReader(CatalogReader&& other) noexcept : slot(other.slot), snapshot(other.snapshot) {
+        other.slot = nullptr;
+    }
+    CatalogReader& operator=(CatalogReader&& other) noexcept;
+    CatalogReader(const CatalogReader&) = delete;
+    CatalogReader& operator=(const CatalogReader&) = delete;
+    ~CatalogReader() { release(); }
+
+    void release();
+
+    const CatalogSnapshot& operator*() const { return *snapshot; }
+    const CatalogSnapshot* operator->() const { return snapshot; }
+};
+
+// Publishes catalog versions for lock-free readers (read-copy-update).
+// The current version is an atomic pointer; readers pin it by announcing the
+// global epoch in a reader slot, so neither side ever waits on the other.
+// A replaced version is retired with the epoch it was replaced in and
+// reclaimed once no slot still announces that epoch or an older one.
+//
+// Every change is published when it is made. Reclaimed versions, and the
+// chunks and course copies they alone held, are kept as spares and
+// overwritten by later versions, so a steady stream of registrations
+// publishes without allocating once the spares are warm.
+//
+// read() may be called from any thread. Every other member is for the
+// writer, and calls must not overlap (callers of the RegistrationSystem
+// serialize on the engine lock, see SessionExecutor::engineLock()).
+class SnapshotPublisher {
+public:
+    static const size_t READER_SLOTS = 64;   // Concurrent readers before read() has to spin
+
+private:
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};   // 0 = free
+    };
+
+    mutable ReaderSlot slots[READER_SLOTS];
+    std::atomic<uint64_t> epoch{1};
+    std::atomic<const CatalogSnapshot*> current{nullptr};
+    std::vector<std::pair<uint64_t, CatalogSnapshot*>> retired;   // (epoch replaced in, version)
+
+    // Chunks and courses the version being built replaced; they are retired
+    // with the version before it
+    std::vector<std::shared_ptr<const CatalogSnapshot::Chunk>> replacedChunks;
+    std::vector<std::shared_ptr<const Course>> replacedCourses;
+    std::vector<std::pair<uint64_t, std::shared_ptr<const CatalogSnapshot::Chunk>>> retiredChunks;
+    std::vector<std::pair<uint64_t, std::shared_ptr<const Course>>> retiredCourses;
+    // Reclaimed storage, reused by nextVersion and place
+    std::vector<CatalogSnapshot*> spareVersions;
+    std::vector<std::shared_ptr<CatalogSnapshot::Chunk>> spareChunks;
+    std::vector<std::shared_ptr<Course>> spareCourses;
+
+    // Swaps in next, retires the previous version and reclaims what it can
+    void publish(CatalogSnapshot* next);
+    // Copy of the current chunk list and index, one version up
+    CatalogSnapshot* nextVersion();
+    // Writable copy of chunk 'at' in next (copied once per version)
+    CatalogSnapshot::Chunk& ownChunk(CatalogSnapshot& next, size_t at);
+    // Copy-on-write of one course into next: added if new, replaced otherwise
+    void place(CatalogSnapshot& next, const Course& course);
+
+public:
+    SnapshotPublisher();
+    ~SnapshotPublisher();
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    // Pins the latest published version; never blocks on the writer
+    CatalogReader read() const;
+
+    // Full rebuild (load, term rollover, batch allocation)
+    void publishAll(const CourseStore& courses);
+    // Publishes the changed courses together as one version, so a reader
+    // never sees half of a change that spans courses (e.g. a swap);
+    // nullptr entries are skipped
+    void publishCourses(std::initializer_list<const Course*> changed);
+    void publishCourses(const std::vector<const Course*>& changed);
+    void publishCourse(const Course& course) { publishCourses({&course}); }
+    // Removes a course; the last course moves into its position
+    void withdrawCourse(CourseCode code);
+
+    uint64_t currentVersion() const;
+    // Replaced versions still waiting for readers to let go
+    size_t retiredCount() const { return retired.size(); }
+    // Frees every retired version no reader can still see
+    void reclaim();
+};
+
+#endif // CATALOG_SNAPSHOT_H
@@ -0,0 +1,76 @@
+#ifndef CATALOG_VIEW_H
+#define CATALOG_VIEW_H
+
+#include "Course.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Filter for scanning the catalog; unset fields (-1 / false) match everything
+struct CatalogQuery {
+    int day = -1;               // 0 = Monday ... 6 = Sunday
+    int startsAtOrAfter = -1;   // Minutes since midnight
+    int endsAtOrBefore = -1;    // Minutes since midnight
+    bool openSeatsOnly = false;
+};
+
+// Columnar (structure-of-arrays) copy of the catalog for scan-heavy queries.
+// One row per section meeting (sections without meetings get one row with
+// day -1). Numeric fields live in parallel arrays so filters touch only the
+// columns they need; codes and titles live in a single string pool.
+//
+// The view is derived from the authoritative Course records. Seat counts are
+// patched in place on enroll/drop; structural edits mark it stale and it is
+// rebuilt on the next refresh().
+class CatalogView {
+private:
+    // Per-row columns
+    std::vector<int32_t> capacity;
+    std::vector<int32_t> enrolled;
+    std::vector<int16_t> day;
+    std::vector<int16_t> start;
+    std::vector<int16_t> end;
+    std::vector<uint32_t> rowCourse;      // Index into the per-course columns
+    std::vector<uint32_t> rowSection;     // Index into the per-section columns
+
+    // Per-course and per-section string columns: (offset, length) into the pool
+    std::string pool;
+    std::vector<std::pair<uint32_t, uint32_t>> courseCode;
+    std::vector<std::pair<uint32_t, uint32_t>> courseTitle;
+    std::vector<std::pair<uint32_t, uint32_t>> sectionName;
+
+    std::unordered_map<const Section*, std::pair<uint32_t, uint32_t>> sectionRows;  // Row range
+    bool stale;
+
+    std::pair<uint32_t, uint32_t> intern(std::string_view text);
+    std::string_view view(std::pair<uint32_t, uint32_t> ref) const;
+
+public:
+    CatalogView();
+
+    void invalidate();
+    bool isStale() const;
+    // Rebuilds from the records if stale
+    void refresh(const CourseStore& courses);
+
+    // Keeps seat columns in sync after a roster change without a rebuild
+    void onSeatsChanged(const Section& section);
+
+    size_t rowCount() const;
+    std::string_view getCode(size_t row) const;
+    std::string_view getTitle(size_t row) const;
+    std::string_view getSectionID(size_t row) const;
+    int getCapacity(size_t row) const;
+    int getEnrolled(size_t row) const;
+    int getDay(size_t row) const;
+    int getStart(size_t row) const;
+    int getEnd(size_t row) const;
+
+    // Rows matching the query, in catalog order
+    std::vector<uint32_t> filter(const CatalogQuery& query) const;
+};
+
+#endif // CATALOG_VIEW_H
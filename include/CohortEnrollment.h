@@ -0,0 +1,59 @@
+#ifndef COHORT_ENROLLMENT_H
+#define COHORT_ENROLLMENT_H
+
+#include "BatchAllocator.h"
+#include "Keys.h"
+#include "RegistrationResult.h"
+#include "Student.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Which students a cohort enrollment takes; the criteria combine. With an
+// explicit ID list only those records are looked up, otherwise every
+// student is scanned.
+struct CohortSelector {
+    std::string major;                      // Empty = any major; compared ignoring case
+    std::string fromID;                     // Student ID range by number (S1000..S1999), inclusive;
+    std::string toID;                       // either end may be empty
+    std::vector<std::string> studentIDs;    // Empty = scan every student
+
+    bool matches(const Student& student) const;
+    // One student ID per line; blank lines and '#' comments are skipped.
+    // Throws FileException if the file cannot be read.
+    static std::vector<std::string> readIdFile(const std::string& path);
+};
+
+enum class CohortFill {
+    Partial,        // Seat students in priority order until a course runs out
+    AllOrNothing    // Change nothing unless every eligible student gets a seat
+};
+
+struct CohortPolicy {
+    CohortFill fill = CohortFill::Partial;
+    PriorityPolicy priority = PriorityPolicy::ClassYear;   // Who is seated first when seats run short
+    uint64_t seed = 1;       // Seed for the random tiebreak
+    unsigned threads = 0;    // For the conflict checks; 0 = hardware concurrency
+};
+
+// A selected student who was not enrolled; result describes the first
+// course of the batch that could not be given
+struct CohortFailure {
+    StudentId studentID;
+    RegistrationResult result;
+};
+
+struct CohortReport {
+    std::vector<std::string> courses;
+    size_t selected = 0;
+    size_t enrolled = 0;
+    bool applied = true;                    // false: AllOrNothing found too few seats
+    std::vector<CohortFailure> failures;    // Sorted by student ID
+    std::vector<std::string> unknownIDs;    // Listed IDs with no student record
+
+    void print(std::ostream& out) const;
+};
+
+#endif // COHORT_ENROLLMENT_H
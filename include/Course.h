@@ -1,52 +1,66 @@
 #ifndef COURSE_H
 #define COURSE_H
 
+#include "Section.h"
+#include "SlabStore.h"
 #include <string>
 #include <vector>
 
+// A course groups one or more sections under a single course code.
+// Capacity and rosters are tracked per section.
 class Course {
 private:
-    std::string code;
+    CourseCode code;
     std::string title;
-    int capacity;
-    std::vector<std::string> enrolledStudentIDs;
-    
-    // Schedule information
-    std::string dayOfWeek;
-    std::string startTime;
-    std::string endTime;
-
-    // Helper method
-    int timeToMinutes(const std::string& time) const;
+    std::vector<Section> sections;
 
 public:
     Course();
-    Course(const std::string& code, const std::string& title, int capacity);
-    Course(const std::string& code, const std::string& title, int capacity,
+    Course(CourseCode code, const std::string& title);
+    Course(CourseCode code, const std::string& title, int capacity);
+    Course(CourseCode code, const std::string& title, int capacity,
            const std::string& dayOfWeek, const std::string& startTime, const std::string& endTime);
 
-    const std::string& getCode() const;
+    CourseCode getCode() const;
     const std::string& getTitle() const;
+
+    // Totals across all sections
     int getCapacity() const;
     int seatsRemaining() const;
-    const std::vector<std::string>& getEnrolledStudentIDs() const;
-    
-    const std::string& getDayOfWeek() const;
-    const std::string& getStartTime() const;
-    const std::string& getEndTime() const;
-    
-    void setSchedule(const std::string& dayOfWeek, const std::string& startTime, const std::string& endTime);
-    
+    int getEnrolledCount() const;
+    std::vector<StudentId> getEnrolledStudentIDs() const;
+
+    // Section access
+    const std::vector<Section>& getSections() const;
+    Section* findSection(const std::string& sectionID);
+    const Section* findSection(const std::string& sectionID) const;
+    Section* findSectionOf(StudentId studentID);
+    const Section* findSectionOf(StudentId studentID) const;
+    void addSection(const Section& section);
+    void removeSection(const std::string& sectionID);
+
+    // Empty sectionID means the first section
+    void setSchedule(const std::string& dayOfWeek, const std::string& startTime, const std::string& endTime,
+                     const std::string& sectionID = "");
+    void setMeetings(const std::vector<Meeting>& meetings, const std::string& sectionID = "");
+
     // Member 3: Setters for Admin to modify courses
     void setCourseName(const std::string& name);
-    void setCapacity(int newCapacity);
+    void setCapacity(int newCapacity, const std::string& sectionID = "");
     std::string getCourseName() const;
 
-    bool isStudentEnrolled(const std::string& studentID) const;
-    void enrollStudent(const std::string& studentID);
-    void dropStudent(const std::string& studentID);
-    
+    bool isStudentEnrolled(StudentId studentID) const;
+    // Empty sectionID enrolls into the first section with an open seat
+    void enrollStudent(StudentId studentID, const std::string& sectionID = "");
+    void dropStudent(StudentId studentID);
+    // Empties every section's roster (term rollover)
+    void clearRosters();
+
+    // True if every section of this course conflicts with some section of other
     bool hasTimeConflict(const Course& other) const;
 };
 
-#endif
\ No newline at end of file
+// Stable-address storage for the live catalog
+typedef SlabStore<Course> CourseStore;
+
+#endif
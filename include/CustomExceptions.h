@@ -1,6 +1,7 @@
 #ifndef CUSTOM_EXCEPTIONS_H
 #define CUSTOM_EXCEPTIONS_H
 
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
@@ -35,6 +36,60 @@ public:
     std::string getConflictDay() const { return conflictDay; }
 };
 
+// Exception for a prerequisite not completed or a corequisite not taken
+class PrerequisiteException : public RegistrationException {
+private:
+    std::string course;
+    std::string missingCourse;
+    
+public:
+    PrerequisiteException(const std::string& course, const std::string& missing, bool corequisite)
+        : RegistrationException(message(course, missing, corequisite)),
+          course(course), missingCourse(missing) {}
+    
+    static std::string message(const std::string& course, const std::string& missing, bool corequisite) {
+        return corequisite
+            ? course + " must be taken together with " + missing + " (corequisite not enrolled or completed)"
+            : course + " requires " + missing + " (prerequisite not completed)";
+    }
+    
+    std::string getCourse() const { return course; }
+    std::string getMissingCourse() const { return missingCourse; }
+};
+
+// Exception for a request rejected by a registration rule (rules.txt)
+class RuleViolationException : public RegistrationException {
+private:
+    std::string ruleName;
+    
+public:
+    RuleViolationException(const std::string& course, const std::string& rule, const std::string& ruleText)
+        : RegistrationException(message(course, rule, ruleText)), ruleName(rule) {}
+    
+    static std::string message(const std::string& course, const std::string& rule, const std::string& ruleText) {
+        return "Registration for " + course + " rejected by rule '" + rule + "' (" + ruleText + ")";
+    }
+    
+    std::string getRuleName() const { return ruleName; }
+};
+
+// Exception for a request turned away by admission control (queue full)
+class TryLaterException : public RegistrationException {
+private:
+    uint32_t retryAfterMs;
+    
+public:
+    TryLaterException(const std::string& course, uint32_t retryAfterMs)
+        : RegistrationException(message(course, retryAfterMs)), retryAfterMs(retryAfterMs) {}
+    
+    static std::string message(const std::string& course, uint32_t retryAfterMs) {
+        return "Registration for " + course + " is busy. Try again in about " +
+               std::to_string((retryAfterMs + 999) / 1000) + " s";
+    }
+    
+    uint32_t getRetryAfterMs() const { return retryAfterMs; }
+};
+
 // Exception for invalid input (email, ID, etc.)
 class InvalidInputException : public RegistrationException {
 private:
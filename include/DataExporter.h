@@ -0,0 +1,63 @@
+#ifndef DATA_EXPORTER_H
+#define DATA_EXPORTER_H
+
+#include "Course.h"
+#include "Student.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class ExportEntity {
+    Catalog,   // One row per section
+    Rosters,   // One row per enrolled student per section
+    Students   // One row per student
+};
+
+enum class ExportFormat {
+    CSV,
+    JSONLines
+};
+
+struct ExportOptions {
+    ExportEntity entity = ExportEntity::Catalog;
+    ExportFormat format = ExportFormat::CSV;
+    std::vector<std::string> fields;   // Empty = every field of the entity
+    std::string major;                 // Rosters/Students: only this major
+    std::string courseCode;            // Only this course (Students: enrolled in it)
+};
+
+// Selected fields of the matching rows, copied out of the live stores so it
+// can be written while the system keeps changing. Cells are packed into one
+// string; cellEnds marks where each cell stops.
+class ExportSnapshot {
+private:
+    std::vector<std::string> fields;
+    std::vector<bool> numeric;     // Written unquoted in JSON Lines
+    std::string cells;
+    std::vector<size_t> cellEnds;
+
+    friend class DataExporter;
+
+public:
+    const std::vector<std::string>& getFields() const { return fields; }
+    size_t rowCount() const { return fields.empty() ? 0 : cellEnds.size() / fields.size(); }
+};
+
+// Streams snapshots as CSV or JSON Lines through a fixed-size buffer, so
+// memory stays constant however many rows are written.
+class DataExporter {
+public:
+    static const size_t BUFFER_SIZE = 64 * 1024;
+
+    static std::vector<std::string> availableFields(ExportEntity entity);
+
+    // Throws InvalidInputException for a field the entity does not have
+    static ExportSnapshot snapshot(const CourseStore& courses, const StudentStore& students,
+                                   const ExportOptions& options);
+
+    // Returns the number of rows written
+    static size_t write(const ExportSnapshot& snapshot, ExportFormat format, std::ostream& out);
+};
+
+#endif // DATA_EXPORTER_H
@@ -0,0 +1,53 @@
+#ifndef ENROLLMENT_ANALYTICS_H
+#define ENROLLMENT_ANALYTICS_H
+
+#include "Course.h"
+#include "Student.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+// GPA histogram buckets: [0,1) [1,2) [2,3) [3,3.5) [3.5,4]
+const int GPA_BUCKETS = 5;
+
+struct CourseStats {
+    std::string code;
+    int capacity = 0;
+    int enrolled = 0;
+    int gpaHistogram[GPA_BUCKETS] = {0, 0, 0, 0, 0};
+    double gpaSum = 0.0;
+    int gpaCount = 0;   // Enrolled students found in the student records
+
+    double fillRate() const { return capacity > 0 ? static_cast<double>(enrolled) / capacity : 0.0; }
+    double averageGPA() const { return gpaCount > 0 ? gpaSum / gpaCount : 0.0; }
+};
+
+struct MajorStats {
+    std::string major;
+    int students = 0;
+    long enrollments = 0;
+    double gpaSum = 0.0;
+};
+
+struct AnalyticsReport {
+    std::vector<CourseStats> courses;          // Catalog order
+    std::vector<MajorStats> majors;            // Sorted by major
+    long demandByDayHour[7][24] = {};          // Enrolled seats per meeting start slot
+    long totalCapacity = 0;
+    long totalEnrolled = 0;
+    size_t studentCount = 0;
+    double elapsedMs = 0.0;
+
+    void print(std::ostream& out) const;
+};
+
+// Computes admin enrollment aggregates with parallel reductions: courses and
+// students are split into contiguous chunks, each worker fills its own
+// partial result, and the partials are merged once at the end.
+class EnrollmentAnalytics {
+public:
+    // threads = 0 uses hardware concurrency
+    static AnalyticsReport compute(const CourseStore& courses, const StudentStore& students, unsigned threads = 0);
+};
+
+#endif // ENROLLMENT_ANALYTICS_H
@@ -0,0 +1,128 @@
+#ifndef ENROLLMENT_LOG_H
+#define ENROLLMENT_LOG_H
+
+#include "Keys.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class EnrollmentOp : uint8_t {
+    Registered = 1,
+    Dropped,
+    SwappedOut,       // The course given up in a swap
+    SwappedIn,        // The course taken in its place
+    SeatRequested,    // One ranked choice submitted during an allocation window
+    SeatAllocated,    // Seat granted when the window closed
+    SeatRevoked,      // Seat lost to a course removal, section cancellation or schedule change
+    CourseAdded,
+    CourseRemoved,
+    TitleChanged,
+    CapacityChanged,
+    MeetingsChanged,
+    SectionAdded,
+    TermRolledOver,   // Every roster cleared for a new term
+    SectionCancelled
+};
+
+const char* enrollmentOpName(EnrollmentOp op);
+
+// One change, in the exact form stored on disk (40 bytes, host byte order).
+// Codes are the fixed 8-byte keys, which stay valid across runs, unlike
+// slab handles.
+struct EnrollmentEvent {
+    int64_t time = 0;        // Microseconds since the Unix epoch
+    StudentId student;       // Empty for course and term events
+    CourseCode course;       // Empty for term events
+    UserId actor;            // Student ID or admin user ID; empty if unknown
+    char section[4] = {};    // Zero padded
+    EnrollmentOp op = EnrollmentOp::Registered;
+    uint8_t reserved[3] = {};
+
+    std::string_view sectionID() const;
+    void setSection(std::string_view sectionID);   // Keeps the first four characters
+    // True for ops that give the student a seat in the course / take one away
+    bool grantsSeat() const;
+    bool releasesSeat() const;
+};
+
+static_assert(sizeof(EnrollmentEvent) == 40, "enrollment events are fixed-size records");
+
+// Any field left empty matches everything
+struct EventQuery {
+    int64_t from = INT64_MIN;   // Inclusive
+    int64_t to = INT64_MAX;     // Inclusive
+    StudentId student;
+    CourseCode course;
+};
+
+// Append-only history of enrollment and course changes, kept as numbered
+// segment files of fixed-size records in time order. The time index holds
+// the first and last timestamp of every segment (read from its first and
+// last record when the log is opened), so a time-range query reads only the
+// segments that overlap the range, and within each only the records inside
+// it (found by binary search on the fixed-size records).
+//
+// Appends are buffered and written in batches; queries include events not
+// yet written. Owned by the registration system's writer thread.
+class EnrollmentLog {
+public:
+    static const size_t SEGMENT_EVENTS = 65536;   // Records per segment file (2.5 MB)
+    static const size_t FLUSH_EVENTS = 256;       // Buffered appends before a write
+
+private:
+    struct Segment {
+        uint32_t number;
+        int64_t first;
+        int64_t last;
+        size_t count;   // Records on disk
+    };
+
+    std::string directory;
+    mutable bool indexed;
+    mutable std::vector<Segment> segments;   // Oldest first
+    std::vector<EnrollmentEvent> pending;    // Belong to the last segment
+    int64_t lastTime;
+    // The last segment, kept open between flushes so a steady stream of
+    // appends does not allocate
+    std::ofstream segmentFile;
+    uint32_t openSegment;
+
+    void buildIndex() const;
+    std::string segmentPath(uint32_t number) const;
+    // Appends the events of segment within [from, to] to out
+    void readSegment(const Segment& segment, int64_t from, int64_t to, std::vector<EnrollmentEvent>& out) const;
+
+public:
+    explicit EnrollmentLog(std::string directory);
+    // Writes any buffered events; errors are ignored here, call flush() to see them
+    ~EnrollmentLog();
+    EnrollmentLog(const EnrollmentLog&) = delete;
+    EnrollmentLog& operator=(const EnrollmentLog&) = delete;
+
+    // Stamps the event with the current time (never earlier than the last
+    // event, so segments stay sorted) and buffers it
+    void append(EnrollmentEvent event);
+    // Throws FileException if the segment cannot be written
+    void flush();
+
+    // Matching events in time order
+    std::vector<EnrollmentEvent> find(const EventQuery& query) const;
+    // Every event in [from, to] in time order, segment by segment
+    void scan(int64_t from, int64_t to, const std::function<void(const EnrollmentEvent&)>& visit) const;
+
+    size_t segmentCount() const;
+    size_t eventCount() const;
+
+    static int64_t now();
+    // "YYYY-MM-DD HH:MM:SS" in local time; false if the text is not a valid time
+    static bool parseTime(const std::string& text, int64_t& time);
+    static std::string formatTime(int64_t time);
+    static void print(std::ostream& out, const EnrollmentEvent& event);
+};
+
+#endif // ENROLLMENT_LOG_H
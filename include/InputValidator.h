@@ -30,6 +30,18 @@ public:
     // Day of week validation
     static bool isValidDayOfWeek(const string& day);
     
+    // Section ID validation (1-4 letters or digits, e.g. 001, L01)
+    static bool isValidSectionID(const string& sectionID);
+    
+    // Term ID validation (letters, digits and dashes, 1-12 characters, e.g. 2026-FALL)
+    static bool isValidTermID(const string& termID);
+    
+    // Single meeting validation (valid day, valid times, start before end)
+    static bool isValidMeeting(const string& day, const string& startTime, const string& endTime);
+    
+    // Meeting list validation ("Monday 09:00-10:30,Wednesday 09:00-10:30"), no overlaps
+    static bool isValidMeetingList(const string& spec);
+    
     // Password strength validation (minimum 6 characters)
     static bool isValidPassword(const string& password);
     
@@ -45,6 +57,9 @@ public:
     // Check if string is a valid positive integer
     static bool isValidPositiveInteger(const string& input);
     
+    // A menu line read as an integer (surrounding spaces allowed); fallback if it is not one
+    static int parseInteger(const string& input, int fallback = -1);
+    
     // Validate capacity (positive integer, reasonable range)
     static bool isValidCapacity(int capacity);
 };
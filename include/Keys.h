@@ -0,0 +1,147 @@
+#ifndef KEYS_H
+#define KEYS_H
+
+#include "CustomExceptions.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Up to eight ASCII characters packed into one 64-bit word, zero padded.
+// Equality and hashing are single-word operations and the characters can be
+// viewed in place as a string_view. Tag supplies the strict input format.
+template <typename Tag>
+class FixedKey {
+private:
+    char chars[8] = {};
+
+public:
+    static constexpr size_t MAX_LENGTH = 8;
+
+    // Anything stored in the data files: 1-8 printable characters, none of
+    // the file separators
+    static constexpr bool fits(std::string_view text) {
+        if (text.empty() || text.size() > MAX_LENGTH) return false;
+        for (char c : text) {
+            if (c <= ' ' || c > '~' || c == '|' || c == ',' || c == ';' || c == ':') return false;
+        }
+        return true;
+    }
+
+    // The format new input must follow (see Tag)
+    static constexpr bool isValidFormat(std::string_view text) { return Tag::isValidFormat(text); }
+
+    constexpr FixedKey() {}
+
+    // Implicit so string call sites keep working; throws if the text does not fit
+    constexpr FixedKey(std::string_view text) {
+        if (!fits(text)) {
+            throw InvalidInputException(Tag::name(), std::string(text), "expected 1-8 characters without separators");
+        }
+        for (size_t i = 0; i < text.size(); ++i) chars[i] = text[i];
+    }
+    FixedKey(const std::string& text) : FixedKey(std::string_view(text)) {}
+    constexpr FixedKey(const char* text) : FixedKey(std::string_view(text)) {}
+
+    // Non-throwing parse; false if the text does not fit
+    static constexpr bool tryParse(std::string_view text, FixedKey& key) {
+        if (!fits(text)) return false;
+        key = FixedKey(text);
+        return true;
+    }
+
+    constexpr uint64_t word() const { return std::bit_cast<uint64_t>(chars); }
+    constexpr bool empty() const { return chars[0] == '\0'; }
+    constexpr size_t size() const {
+        size_t n = 0;
+        while (n < MAX_LENGTH && chars[n] != '\0') ++n;
+        return n;
+    }
+
+    constexpr std::string_view view() const { return std::string_view(chars, size()); }
+    constexpr operator std::string_view() const { return view(); }
+    std::string str() const { return std::string(view()); }
+
+    constexpr bool operator==(const FixedKey& other) const { return word() == other.word(); }
+    constexpr bool operator!=(const FixedKey& other) const { return word() != other.word(); }
+    constexpr bool operator<(const FixedKey& other) const { return view() < other.view(); }
+
+    // Comparing with text never throws, even if the text could not be a key
+    friend constexpr bool operator==(const FixedKey& key, std::string_view text) { return key.view() == text; }
+    friend constexpr bool operator!=(const FixedKey& key, std::string_view text) { return key.view() != text; }
+    friend bool operator==(const FixedKey& key, const std::string& text) { return key.view() == text; }
+    friend bool operator!=(const FixedKey& key, const std::string& text) { return key.view() != text; }
+    friend bool operator==(const FixedKey& key, const char* text) { return key.view() == text; }
+    friend bool operator!=(const FixedKey& key, const char* text) { return key.view() != text; }
+
+    // Message building ("Course " + code + ...)
+    friend std::string operator+(const std::string& text, const FixedKey& key) { return text + key.str(); }
+    friend std::string operator+(const FixedKey& key, const std::string& text) { return key.str() + text; }
+    friend std::string operator+(const char* text, const FixedKey& key) { return text + key.str(); }
+    friend std::string operator+(const FixedKey& key, const char* text) { return key.str() + text; }
+
+    friend std::ostream& operator<<(std::ostream& out, const FixedKey& key) { return out << key.view(); }
+};
+
+struct CourseCodeTag {
+    static const char* name() { return "course code"; }
+    // 2-4 uppercase letters followed by 3 digits (e.g. CS101, MATH201)
+    static constexpr bool isValidFormat(std::string_view text) {
+        size_t letters = 0;
+        while (letters < text.size() && text[letters] >= 'A' && text[letters] <= 'Z') ++letters;
+        if (letters < 2 || letters > 4 || text.size() != letters + 3) return false;
+        for (size_t i = letters; i < text.size(); ++i) {
+            if (text[i] < '0' || text[i] > '9') return false;
+        }
+        return true;
+    }
+};
+
+struct StudentIdTag {
+    static const char* name() { return "student ID"; }
+    // 'S' followed by 4-6 digits (e.g. S1001)
+    static constexpr bool isValidFormat(std::string_view text) {
+        if (text.size() < 5 || text.size() > 7 || text[0] != 'S') return false;
+        for (size_t i = 1; i < text.size(); ++i) {
+            if (text[i] < '0' || text[i] > '9') return false;
+        }
+        return true;
+    }
+};
+
+struct UserIdTag {
+    static const char* name() { return "user ID"; }
+    // Letters and digits (e.g. A001, U12)
+    static constexpr bool isValidFormat(std::string_view text) {
+        if (text.empty() || text.size() > 8) return false;
+        for (char c : text) {
+            bool alnum = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+            if (!alnum) return false;
+        }
+        return true;
+    }
+};
+
+typedef FixedKey<CourseCodeTag> CourseCode;
+typedef FixedKey<StudentIdTag> StudentId;
+typedef FixedKey<UserIdTag> UserId;
+
+static_assert(sizeof(CourseCode) == 8 && sizeof(StudentId) == 8 && sizeof(UserId) == 8, "keys must stay one word");
+static_assert(CourseCode::isValidFormat("MATH201") && !CourseCode::isValidFormat("M201"), "course code format");
+static_assert(StudentId::isValidFormat("S1001") && !StudentId::isValidFormat("S12"), "student ID format");
+
+namespace std {
+template <typename Tag>
+struct hash<FixedKey<Tag>> {
+    size_t operator()(const FixedKey<Tag>& key) const {
+        // Fibonacci multiply spreads the packed characters over the high bits
+        uint64_t mixed = key.word() * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(mixed ^ (mixed >> 32));
+    }
+};
+} // namespace std
+
+#endif // KEYS_H
@@ -0,0 +1,73 @@
+#ifndef LISTING_RENDERER_H
+#define LISTING_RENDERER_H
+
+#include "CatalogSnapshot.h"
+#include "Course.h"
+#include "Keys.h"
+#include "Student.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Position in a paginated listing. Catalog and student listings resume at a
+// slab slot or catalog position; roster listings resume at (section, position).
+struct ListingCursor {
+    uint32_t slot = 0;
+    size_t section = 0;
+    size_t item = 0;
+    size_t shown = 0;
+    bool started = false;
+    bool done = false;
+};
+
+enum class CatalogStyle {
+    Student,  // Seats remaining per section
+    Admin     // Capacity / enrolled / remaining per section
+};
+
+// Formats listings into one reusable buffer and writes each page with a
+// single write + flush, instead of flushing on every line with std::endl.
+// Course blocks rendered from a catalog snapshot are cached by code and
+// only re-rendered once a later version changed that course.
+class ListingRenderer {
+private:
+    struct CachedBlock {
+        uint64_t changedIn = 0;
+        std::string text;
+    };
+
+    std::string buffer;
+    std::unordered_map<CourseCode, CachedBlock> studentBlocks;
+    std::unordered_map<CourseCode, CachedBlock> adminBlocks;
+
+    static void appendCourse(const Course& course, CatalogStyle style, std::string& into);
+    const std::string& courseBlock(const CatalogSnapshot& catalog, size_t position, CatalogStyle style);
+    void beginCatalog(ListingCursor& cursor, CatalogStyle style, bool empty);
+    void endCatalogPage(const ListingCursor& cursor, CatalogStyle style, size_t total,
+                        std::ostream& out);
+    void writePage(std::ostream& out);
+    // Student listing pieces shared by both renderStudentsPage forms
+    bool beginStudents(ListingCursor& cursor, size_t total, std::ostream& out);
+    void appendStudent(const Student& student);
+    void endStudentsPage(const ListingCursor& cursor, size_t total, std::ostream& out);
+
+public:
+    // Each call renders up to pageSize entries (0 = all) and advances the cursor
+    void renderCatalogPage(const CatalogSnapshot& catalog, CatalogStyle style, ListingCursor& cursor,
+                           size_t pageSize, std::ostream& out);
+    // Uncached; for stores that are listed once (archived terms)
+    void renderCatalogPage(const CourseStore& courses, CatalogStyle style, ListingCursor& cursor,
+                           size_t pageSize, std::ostream& out);
+    void renderRosterPage(const Course& course, ListingCursor& cursor, size_t pageSize, std::ostream& out);
+    void renderStudentsPage(const StudentStore& students, ListingCursor& cursor, size_t pageSize,
+                            std::ostream& out);
+    // For callers that load one page of records at a time: page holds this
+    // page's students out of total, and last ends the listing
+    void renderStudentsPage(const std::vector<const Student*>& page, size_t total, bool last,
+                            ListingCursor& cursor, std::ostream& out);
+};
+
+#endif // LISTING_RENDERER_H
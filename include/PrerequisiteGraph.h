@@ -0,0 +1,69 @@
+#ifndef PREREQUISITE_GRAPH_H
+#define PREREQUISITE_GRAPH_H
+
+#include "Keys.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Prerequisite and corequisite relations between courses.
+// Every course code gets a dense node number. Each node keeps the transitive
+// closure of its prerequisites as a bitset, plus the indexes of its non-zero
+// words, so an eligibility check reads only those words however large the
+// catalog grows. An edit recomputes the closure of the edited course and its
+// dependents only, and is rejected if a course would end up requiring itself.
+class PrerequisiteGraph {
+private:
+    struct Node {
+        CourseCode code;
+        std::vector<uint32_t> prerequisites;   // Direct
+        std::vector<uint32_t> corequisites;    // Direct
+        std::vector<uint32_t> dependents;      // Nodes with this one as a direct prerequisite
+        std::vector<uint64_t> closure;         // Every transitive prerequisite
+        std::vector<uint32_t> closureWords;    // Indexes of the non-zero closure words
+    };
+
+    std::vector<Node> nodes;
+    std::unordered_map<CourseCode, uint32_t> nodeIndex;
+    std::vector<uint64_t> scratch;   // A student's completed courses during a check; all zero between checks
+
+    uint32_t nodeOf(CourseCode code);   // Creates the node on first use
+    const Node* find(CourseCode code) const;
+    // True if node transitively requires other (one bit test)
+    bool dependsOn(uint32_t node, uint32_t other) const;
+    // Rebuilds the closures of node and everything that depends on it
+    void recomputeFrom(uint32_t node);
+    void rebuildClosure(uint32_t node);
+
+public:
+    // Throw InvalidInputException for a self reference, DuplicateEntryException
+    // if the relation exists and RegistrationException if it would make a
+    // course require itself (or a course it must be taken alongside)
+    void addPrerequisite(CourseCode course, CourseCode required);
+    void addCorequisite(CourseCode course, CourseCode other);
+    // Return false if the relation did not exist
+    bool removePrerequisite(CourseCode course, CourseCode required);
+    bool removeCorequisite(CourseCode course, CourseCode other);
+    // Drops every relation that mentions code (course removed from the catalog)
+    void removeCourse(CourseCode code);
+    void clear();
+
+    std::vector<CourseCode> prerequisitesOf(CourseCode course) const;
+    std::vector<CourseCode> corequisitesOf(CourseCode course) const;
+    // Every transitive prerequisite of course
+    std::vector<CourseCode> allPrerequisitesOf(CourseCode course) const;
+
+    // Finds a prerequisite (direct or transitive) that is not in completed, or
+    // else a corequisite in neither completed nor enrolled. Returns false if
+    // there is none, i.e. the student is eligible.
+    bool findMissing(CourseCode course, const std::vector<CourseCode>& completed,
+                     const std::vector<CourseCode>& enrolled, CourseCode& missing, bool& corequisite);
+
+    // One line per course with relations: code|prereq,prereq|coreq,coreq
+    // Missing file means no relations; unusable lines are skipped.
+    void load(const std::string& path);
+    void save(const std::string& path) const;
+};
+
+#endif // PREREQUISITE_GRAPH_H
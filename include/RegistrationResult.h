@@ -0,0 +1,109 @@
+#ifndef REGISTRATION_RESULT_H
+#define REGISTRATION_RESULT_H
+
+#include "Keys.h"
+#include "Section.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class RegistrationStatus : uint8_t {
+    Ok,
+    CourseNotFound,
+    SectionNotFound,
+    AlreadyEnrolled,
+    NotEnrolled,
+    CourseFull,
+    TimeConflict,
+    MissingPrerequisite,
+    MissingCorequisite,
+    RuleViolation,
+    TryLater
+};
+
+// Outcome of a try* registration call. Details are stored as fields (keys are
+// one word and the requested text fits in the small-string buffer, so filling
+// them does not allocate) and a message is only formatted when asked for.
+struct RegistrationResult {
+    RegistrationStatus status = RegistrationStatus::Ok;
+    std::string courseCode;
+    std::string sectionID;           // Requested section, if any
+    StudentId studentID;             // AlreadyEnrolled
+    CourseCode conflictingCourse;    // TimeConflict
+    std::string conflictDay;         // TimeConflict
+    CourseCode missingCourse;        // MissingPrerequisite / MissingCorequisite
+    std::string ruleName;            // RuleViolation
+    std::string ruleText;            // RuleViolation
+    uint32_t retryAfterMs = 0;       // TryLater: estimated wait before a retry is admitted
+
+    bool ok() const { return status == RegistrationStatus::Ok; }
+
+    // Same text as the exception the throwing API raises for this outcome
+    std::string message() const;
+    // Throws that exception; does nothing when ok()
+    void raise() const;
+};
+
+// A student who lost a seat when a course was removed or a section cancelled
+struct DisplacedStudent {
+    StudentId studentID;
+    std::string sectionID;            // Section the seat was in
+    bool placementTried = false;      // An alternative course was given
+    RegistrationResult placement;     // Registration in the alternative, if tried
+};
+
+// Outcome of removeCourse / cancelSection, one entry per roster seat
+struct CancellationReport {
+    CourseCode course;
+    std::string sectionID;            // Cancelled section; empty when the course was removed
+    std::string alternativeCode;      // Empty if none was given
+    std::vector<DisplacedStudent> displaced;
+    size_t placed = 0;
+
+    void print(std::ostream& out) const;
+};
+
+// A proposed change to one section. Fields left unset stay as they are
+struct ScheduleChange {
+    int capacity = -1;                   // -1 = unchanged
+    bool changeMeetings = false;
+    std::vector<Meeting> meetings;
+};
+
+// What happens to students the change affects when it is applied
+enum class ImpactResolution {
+    KeepConflicts,   // Students with a new conflict keep their seat
+    MoveOrKeep,      // Move them to the suggested section; keep the seat if there is none
+    MoveOrDrop       // Move them to the suggested section; drop the course if there is none
+};
+
+// A roster student the change would affect. Students over the new capacity
+// (the most recently enrolled of those who stay after conflicts are
+// resolved) are always moved or dropped.
+struct AffectedStudent {
+    StudentId studentID;
+    bool overCapacity = false;
+    CourseCode conflictingCourse;        // New time conflict; empty if none
+    std::string conflictDay;
+    std::string alternativeSection;      // Open, conflict-free section of the same course; empty if none
+    enum Action : uint8_t { None, Kept, Moved, Dropped } action = None;   // Set when applied
+};
+
+// Impact of a capacity or meeting change on a section's roster
+struct ScheduleImpact {
+    CourseCode course;
+    std::string sectionID;
+    int enrolled = 0;
+    int capacity = 0;                    // After the change
+    size_t overCapacity = 0;
+    size_t conflicts = 0;
+    std::vector<AffectedStudent> affected;   // Roster order
+    bool applied = false;
+    size_t moved = 0;
+    size_t dropped = 0;
+
+    void print(std::ostream& out) const;
+};
+
+#endif // REGISTRATION_RESULT_H
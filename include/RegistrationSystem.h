@@ -4,20 +4,197 @@
 #include "Course.h"
 #include "Student.h"
 #include "CustomExceptions.h"
+#include "BatchAllocator.h"
+#include "CatalogView.h"
+#include "CatalogSnapshot.h"
+#include "ListingRenderer.h"
+#include "EnrollmentAnalytics.h"
+#include "DataExporter.h"
+#include "TermArchive.h"
+#include "ShardLayout.h"
+#include "StudentDirectory.h"
+#include "RegistrationResult.h"
+#include "PrerequisiteGraph.h"
+#include "RuleSet.h"
+#include "EnrollmentLog.h"
+#include "SeatSubscriptions.h"
+#include "CohortEnrollment.h"
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 class RegistrationSystem {
+public:
+    // Attributes the changes made while it lives to userID (e.g. an admin)
+    // in the enrollment log; an empty userID leaves them unattributed.
+    // Throws InvalidInputException if the ID is longer than 8 characters or
+    // contains a separator. Keep it around the calls themselves: it must
+    // not stay alive across a session suspension.
+    class ActorScope {
+    private:
+        RegistrationSystem& system;
+        UserId previous;
+
+    public:
+        ActorScope(RegistrationSystem& system, std::string_view userID);
+        ~ActorScope();
+        ActorScope(const ActorScope&) = delete;
+        ActorScope& operator=(const ActorScope&) = delete;
+    };
+
 private:
-    std::vector<Course> courses;
-    std::vector<Student> students;
+    // Records live in slab stores so pointers handed out (e.g. by login) stay valid
+    CourseStore courses;
+    StudentStore students;
+    std::unordered_map<CourseCode, SlabHandle> courseIndex;    // Course code -> handle
+    std::unordered_map<std::string, SlabHandle> studentIndex;  // Username -> handle
+    std::unordered_map<StudentId, SlabHandle> studentIDIndex;  // Student ID -> handle (resident records)
     std::string studentsFilePath;
-    std::string coursesFilePath;
+    std::string coursesFilePath;   // Active term's catalog and rosters
+
+    // Terms: student records are shared by all terms; only the active term's
+    // catalog is loaded at startup, archived terms load on first access
+    std::string activeTerm;
+    std::vector<std::string> archivedTerms;   // Oldest first
+    mutable std::map<std::string, std::unique_ptr<TermArchive>> loadedTerms;
+
+    // Course relations (prerequisites.txt next to the course file); saved
+    // with the other data when edited
+    PrerequisiteGraph prerequisites;
+    mutable bool prerequisitesDirty;
+
+    // Registration rules compiled from rules.txt next to the course file
+    RuleSet rules;
+
+    // Every enrollment and course change, in enrollment-log/ next to the
+    // course file; written in batches and on save
+    mutable EnrollmentLog eventLog;
+    UserId actor;   // Set by ActorScope; empty for self-service and system changes
+
+    // Hash-partitioned data files; saves rewrite only shards marked dirty
+    ShardLayout courseShards;     // By course code
+    ShardLayout studentShards;    // By username
+    mutable std::vector<char> dirtyCourseShards;
+    mutable std::vector<char> dirtyStudentShards;
+
+    // Lazy student loading (enableLazyStudents): startup only indexes the
+    // student files; records load on login or lookup, and clean, unpinned
+    // records beyond studentCacheCapacity are evicted least recently used first
+    bool lazyStudents;
+    size_t studentCacheCapacity;
+    mutable StudentDirectory studentDirectory;
 
-    Course* findCourse(const std::string& code);
+    // Columnar copy of the catalog for scans; kept in sync by every mutation below
+    mutable CatalogView catalogView;
+    // Buffered listing output; course blocks are cached per catalog version
+    mutable ListingRenderer renderer;
+    // Immutable catalog versions for listings and readers on other threads;
+    // every mutation below publishes the courses it changed
+    SnapshotPublisher snapshots;
+    // Seat-availability watchers; told about every seat change alongside catalogView
+    SeatSubscriptions seatWatches;
+
+    // Batch allocation window state
+    bool allocationWindowOpen;
+    std::vector<SeatRequest> pendingRequests;
+
+    // Background export: the snapshot is taken on the calling thread, the
+    // file is written by exportWorker while sessions continue
+    std::thread exportWorker;
+    std::atomic<bool> exportFailed;
+    std::string exportPath;
+
+    Course* findCourse(std::string_view code);
+    Course& requireCourse(const std::string& code);
+    void rebuildCourseIndex();
     Student* findStudent(const std::string& username);
+    // Loads the record on demand in lazy mode
+    Student* findStudent(StudentId studentID);
+
+    struct StudentRecord;
+    // False if the student ID does not fit a StudentId; such lines are skipped
+    static bool parseStudentLine(const std::string& line, StudentRecord& record);
+    Student* addResidentStudent(StudentRecord& record);
+    bool readStudentAt(const StudentLocation& location, StudentRecord& record) const;
+    void evictStudents(uint32_t keepSlot);
+    // Whole-population operations in lazy mode: makes every record resident
+    // and pins it (slots go to pinned) until releaseRoster, after which the
+    // working set shrinks back to studentCacheCapacity
+    void pinAllStudents(std::vector<uint32_t>& pinned);
+    class AllStudentsResident {
+    private:
+        RegistrationSystem& system;
+        std::vector<uint32_t> pinned;
+
+    public:
+        explicit AllStudentsResident(const RegistrationSystem& system);
+        ~AllStudentsResident();
+        AllStudentsResident(const AllStudentsResident&) = delete;
+        AllStudentsResident& operator=(const AllStudentsResident&) = delete;
+    };
+    void saveStudentShardsMerged() const;
+
+    // Scratch buffers for registration, reused across calls to avoid allocation
+    std::vector<std::pair<const Meeting*, CourseCode>> scheduleOrder;
+    std::vector<Meeting> scheduleScratch;
+    std::vector<CourseCode> scheduleOwners;
+    std::vector<CourseCode> swapEnrolled;
+
+    // Student's current weekly meetings sorted by start (scheduleScratch),
+    // with the owning course code of each (scheduleOwners); meetings of
+    // 'excluded' are left out (the course being swapped away)
+    void buildSchedule(const Student& student, CourseCode excluded = CourseCode());
 
     static std::vector<std::string> split(const std::string& input, char delimiter);
+    static Course parseCourseLine(const std::string& line);
+    static bool readCourseFile(const std::string& path, CourseStore& store);
+    static void writeCourseFile(const CourseStore& store, const std::string& path);
+    static void writeCourseLine(std::ostream& out, const Course& course);
+    static void writeStudentLine(std::ostream& out, const Student& student);
+    std::string shardsFilePath() const;
+    void loadShardCount();
+    void markCourseDirty(std::string_view code);
+    void markStudentDirty(const Student& student);
+    void markAllDirty();
+    std::string termsFilePath() const;
+    std::string termArchivePath(const std::string& termID) const;
+    void loadTerms();
+    void saveTerms() const;
+    std::string prerequisitesFilePath() const;
+    // Fills result with MissingPrerequisite / MissingCorequisite and returns
+    // false if the student may not take course (enrolled: current courses)
+    bool checkEligibility(const Student& student, CourseCode course, const std::vector<CourseCode>& enrolled,
+                          RegistrationResult& result);
+    std::string rulesFilePath() const;
+    std::string enrollmentLogPath() const;
+    // Records a change; the actor is the scoped one, else the student
+    void logEvent(EnrollmentOp op, CourseCode course, StudentId student = StudentId(), std::string_view sectionID = "");
+    // Everything but the section; dropping is a course being swapped away
+    void fillRuleContext(const Student& student, CourseCode course, CourseCode dropping, RuleContext& context) const;
+    void setRuleViolation(int rule, RegistrationResult& result) const;
+    // Course removal and section cancellation: the records of everyone on
+    // the roster are loaded (and pinned in lazy mode) before anything
+    // changes, then each loses the course, then the alternative is tried
+    std::vector<Student*> gatherRoster(const Section& section, CancellationReport& report,
+                                       std::vector<uint32_t>& pinned);
+    void releaseRoster(const std::vector<uint32_t>& pinned);
+    void revokeSeats(CourseCode code, const std::vector<Student*>& affected, const CancellationReport& report);
+    void placeDisplaced(const std::vector<Student*>& affected, CancellationReport& report);
+    // Affected students of a schedule change; their records go to records
+    // (nullptr if missing) and are pinned in lazy mode. Overflow is counted
+    // among the students who stay once conflicts are resolved by resolution.
+    ScheduleImpact computeImpact(Course& course, Section& section, const ScheduleChange& change,
+                                 ImpactResolution resolution,
+                                 std::vector<Student*>& records, std::vector<uint32_t>& pinned);
+    // Re-checks every watched course after changes that touch many at once
+    void refreshSeatWatches();
     void loadCourses();
     void loadStudents();
     void saveCourses() const;
@@ -25,28 +202,168 @@ private:
 
 public:
     RegistrationSystem(const std::string& studentsFilePath, const std::string& coursesFilePath);
+    ~RegistrationSystem();
 
+    // Shards are read in parallel; saves write only the shards that changed
     void loadData();
     void saveData() const;
 
-    const std::vector<Course>& getCourses() const;
-    const std::vector<Student>& getStudents() const;
+    size_t getShardCount() const;
+    // Rewrites all data into newCount shard files and removes the old ones
+    void reshard(size_t newCount);
+
+    // Call before loadData to load students on demand, keeping at most
+    // cacheCapacity clean records in memory (logged-in students are pinned)
+    void enableLazyStudents(size_t cacheCapacity);
+    size_t getStudentCount() const;
+    // Loads the record on demand in lazy mode
+    const Student* findStudentByID(const std::string& studentID);
 
-    Student& createStudent(const std::string& username,
-                           const std::string& password,
-                           const std::string& email,
-                           const std::string& name,
-                           const std::string& userID,
-                           const std::string& studentID,
-                           const std::string& major,
+    // The published catalog (see readCatalog)
+    CatalogReader getCourses() const;
+    // Resident student records: every student, or in lazy mode only the
+    // working set (listings, analytics and exports still cover everyone)
+    const StudentStore& getStudents() const;
+    const Course* getCourse(std::string_view code) const;
+
+    // Generation-checked handles; a stale handle resolves to nullptr
+    SlabHandle getStudentHandle(const std::string& username) const;
+    Student* getStudent(SlabHandle handle);
+
+    Student& createStudent(std::string username,
+                           std::string password,
+                           std::string email,
+                           std::string name,
+                           std::string userID,
+                           std::string studentID,
+                           std::string major,
                            double gpa);
 
+    // Term-scoped catalogs. Archived terms are read-only and loaded on demand
+    const std::string& getActiveTerm() const;
+    const std::vector<std::string>& getArchivedTerms() const;
+    const TermArchive& getArchivedTerm(const std::string& termID) const;
+    // Archives the active term's catalog and rosters, then opens newTermID with
+    // the same courses and sections but empty rosters
+    void rolloverTerm(const std::string& newTermID);
+
+    // Admin course management, applied in place to the live catalog
+    void addCourse(const Course& course);
+    // Removes the course from every enrolled student (found through the
+    // rosters, so the cost is the roster size), offers each a seat in
+    // alternativeCode if given, and saves the result
+    CancellationReport removeCourse(const std::string& code, const std::string& alternativeCode = "");
+    // Same for one section; the course keeps its other sections
+    CancellationReport cancelSection(const std::string& code, const std::string& sectionID,
+                                     const std::string& alternativeCode = "");
+    void setCourseTitle(const std::string& code, const std::string& title);
+    // Rejects a capacity below the section's enrollment; applyScheduleChange resolves it instead
+    void setCourseCapacity(const std::string& code, int capacity, const std::string& sectionID = "");
+    void setCourseMeetings(const std::string& code, const std::vector<Meeting>& meetings,
+                           const std::string& sectionID = "");
+    void addCourseSection(const std::string& code, const Section& section);
+
+    // Dry run of a capacity or meeting change to one section: enrolled
+    // students with a new time conflict (against the rest of their
+    // schedule), students over the new capacity, and for each an open,
+    // conflict-free section of the same course. Students who would move or
+    // be dropped for a conflict under resolution do not count toward the new
+    // capacity. Only the section's roster and those students' schedules are read.
+    ScheduleImpact analyzeScheduleChange(const std::string& code, const std::string& sectionID,
+                                         const ScheduleChange& change,
+                                         ImpactResolution resolution = ImpactResolution::KeepConflicts);
+    // Re-runs the analysis, resolves the affected students by policy, then
+    // makes the change
+    ScheduleImpact applyScheduleChange(const std::string& code, const std::string& sectionID,
+                                       const ScheduleChange& change, ImpactResolution resolution);
+
+    // Course relations. Edits are checked for cycles and update the
+    // precomputed closure of the affected courses only
+    const PrerequisiteGraph& getPrerequisites() const;
+    void addPrerequisite(const std::string& code, const std::string& requiredCode);
+    void removePrerequisite(const std::string& code, const std::string& requiredCode);
+    void addCorequisite(const std::string& code, const std::string& otherCode);
+    void removeCorequisite(const std::string& code, const std::string& otherCode);
+
+    // Recompiles rules.txt; on an error the current rules stay in force
+    void reloadRules();
+    const RuleSet& getRules() const;
+
     Student* login(const std::string& username, const std::string& password);
+    // Ends a login; the student may be evicted again in lazy mode
+    void logout(const Student& student);
 
-    void registerForCourse(Student& student, const std::string& courseCode);
+    // Empty sectionID picks the first section with a seat and no time conflict.
+    // The try* forms report rejections as a status instead of throwing; the
+    // plain forms throw the matching RegistrationException.
+    RegistrationResult tryRegisterForCourse(Student& student, const std::string& courseCode,
+                                            const std::string& sectionID = "");
+    RegistrationResult tryDropCourse(Student& student, const std::string& courseCode);
+    void registerForCourse(Student& student, const std::string& courseCode, const std::string& sectionID = "");
     void dropCourse(Student& student, const std::string& courseCode);
 
-    void listCourses() const;
+    // Drops fromCode and adds toCode in one step: the target is checked for
+    // seats and conflicts as if fromCode were already dropped, and nothing
+    // changes unless both sides succeed. fromCode == toCode moves the student
+    // to another section of the same course.
+    RegistrationResult trySwapCourse(Student& student, const std::string& fromCode, const std::string& toCode,
+                                     const std::string& toSectionID = "");
+    void swapCourse(Student& student, const std::string& fromCode, const std::string& toCode,
+                    const std::string& toSectionID = "");
+
+    // Batch allocation mode: requests are collected while the window is open
+    // and resolved together when it closes, instead of first-come-first-served
+    void openAllocationWindow();
+    bool isAllocationWindowOpen() const;
+    void submitSeatRequest(const Student& student, const std::vector<SeatChoice>& rankedChoices);
+    size_t pendingRequestCount() const;
+    AllocationReport closeAllocationWindow(const AllocationPolicy& policy);
+
+    // Enrolls every selected student in all of courseCodes (e.g. a course
+    // and its lab) or in none of them. Eligibility is checked first, then
+    // time conflicts and rules in parallel against the unchanged catalog;
+    // seats are handed out in policy order and the rosters, views and
+    // snapshot are updated once for the whole batch. Throws
+    // RegistrationException if a course is not found.
+    CohortReport enrollCohort(const CohortSelector& selector, const std::vector<std::string>& courseCodes,
+                              const CohortPolicy& policy = CohortPolicy());
+
+    // Paginated listings: each call writes one page and advances the cursor
+    void renderCatalogPage(CatalogStyle style, ListingCursor& cursor, size_t pageSize, std::ostream& out) const;
+    void renderRosterPage(const std::string& code, ListingCursor& cursor, size_t pageSize, std::ostream& out) const;
+    void renderStudentsPage(ListingCursor& cursor, size_t pageSize, std::ostream& out) const;
+
+    // Fill rates, enrollment by major, GPA per course and time-of-day demand
+    AnalyticsReport computeAnalytics(unsigned threads = 0) const;
+
+    // CSV / JSON Lines export of a consistent snapshot; returns rows written
+    size_t exportData(const ExportOptions& options, std::ostream& out) const;
+    // Snapshots now and writes the file in the background; returns the row count
+    size_t startExport(const ExportOptions& options, const std::string& path);
+    // Waits for a background export; throws FileException if it failed
+    void waitForExport();
+
+    // Enrollment history. seatHoldersAt replays the log backwards from the
+    // roster of the term in force at that time (the current one, or the
+    // archive of a term rolled over since), touching only later events.
+    const EnrollmentLog& getEnrollmentLog() const;
+    std::vector<StudentId> seatHoldersAt(const std::string& courseCode, int64_t time) const;
+
+    // Seat-availability notices: the callback runs when the course (or, for a
+    // filter, a matching section) goes from full to open or back. Throws
+    // RegistrationException if the course is not found.
+    SeatSubscriptions::Id watchSeats(const std::string& courseCode, SeatSubscriptions::Callback callback);
+    SeatSubscriptions::Id watchSeats(const SeatFilter& filter, SeatSubscriptions::Callback callback);
+    void unwatchSeats(SeatSubscriptions::Id id);
+
+    // Pins the latest published catalog version. Safe to call from any
+    // thread while this one keeps registering; never blocks either side.
+    // Every mutating call publishes the courses it changed before returning.
+    CatalogReader readCatalog() const;
+
+    // Columnar catalog scans (e.g. open sections on Tuesday after 14:00)
+    const CatalogView& getCatalogView() const;
+    void searchSections(const CatalogQuery& query, std::ostream& out = std::cout) const;
 };
 
 #endif
@@ -0,0 +1,87 @@
+#ifndef RULE_SET_H
+#define RULE_SET_H
+
+#include "Keys.h"
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Facts about one registration attempt, gathered once before the rules run
+struct RuleContext {
+    double gpa = 0.0;
+    double credits = 0.0;            // Enrolled credits including the requested course
+    double courses = 0.0;            // Enrolled courses including the requested one
+    double completedCredits = 0.0;   // Class standing
+    double day = 0.0;                // Day of registration, 1 = opening day
+    std::string_view major;
+    CourseCode course;
+    std::string_view section;
+};
+
+enum class RuleField : uint8_t { Gpa, Credits, Courses, CompletedCredits, Day, Major, Course, Section };
+enum class RuleOp : uint8_t { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual, Prefix };
+
+// Registration rules loaded from a text file (rules.txt next to the course
+// file). The file is compiled once into a flat array of comparisons, so a
+// check is a linear pass with no parsing or tree walking.
+//
+//   opens 2026-08-24                 # registration day 1 (enables 'day')
+//   credits default 3                # credit hours per course
+//   credits CS499 6
+//   rule max-credits: require credits <= 18
+//   rule majors-first: when course ^= CS and day <= 3 require major == CS
+//   rule honors-gpa: when section ^= H require gpa >= 3.0
+//
+// Numeric fields: gpa credits courses completed_credits day
+// Text fields:    major course section  (== != and ^= for prefix)
+class RuleSet {
+private:
+    struct Instruction {
+        RuleField field;
+        RuleOp op;
+        uint32_t text;     // Index into texts for text fields
+        double number;     // Operand for numeric fields
+    };
+    struct Rule {
+        std::string name;
+        std::string source;       // Condition text, for messages
+        uint32_t whenBegin;       // program[whenBegin, requireBegin): when the rule applies
+        uint32_t requireBegin;    // program[requireBegin, end): what it requires
+        uint32_t end;
+    };
+
+    std::vector<Instruction> program;
+    std::vector<std::string> texts;
+    std::vector<Rule> rules;
+    double defaultCredits = 3.0;
+    std::unordered_map<CourseCode, double> courseCredits;
+    bool hasOpens = false;
+    int64_t opensDay = 0;   // Days since the epoch
+
+    bool test(const Instruction& instruction, const RuleContext& context) const;
+    void compileCondition(const std::vector<std::string>& tokens, size_t& pos, const std::string& where);
+
+public:
+    // Throws InvalidInputException naming the line for anything it cannot compile
+    static RuleSet compile(std::istream& in, const std::string& sourceName);
+    // A missing file is an empty rule set
+    static RuleSet load(const std::string& path);
+
+    bool empty() const { return rules.empty(); }
+    size_t size() const { return rules.size(); }
+    const std::string& ruleName(size_t index) const { return rules[index].name; }
+    const std::string& ruleText(size_t index) const { return rules[index].source; }
+
+    // Index of the first rule the attempt breaks, or -1 if it passes all of them
+    int firstViolation(const RuleContext& context) const;
+
+    double creditsOf(CourseCode code) const;
+    // Today's registration day; without an 'opens' line every day-limited
+    // window counts as over
+    double registrationDay() const;
+};
+
+#endif // RULE_SET_H
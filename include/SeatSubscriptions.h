@@ -0,0 +1,86 @@
+#ifndef SEAT_SUBSCRIPTIONS_H
+#define SEAT_SUBSCRIPTIONS_H
+
+#include "Course.h"
+#include "Keys.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Sent when a watched course (or a matching section, for filters) goes from
+// full to having a seat, or back
+struct SeatNotice {
+    CourseCode course;
+    std::string sectionID;   // Empty for a whole-course subscription
+    int seatsRemaining = 0;
+    bool opened = false;     // false: just filled up
+};
+
+// "Any CS section on Monday": a course code prefix and/or a meeting day
+struct SeatFilter {
+    std::string codePrefix;  // Empty = any course
+    int day = -1;            // Section::dayIndex; -1 = any day
+
+    bool matches(CourseCode code) const;
+    bool matches(const Section& section) const;
+};
+
+// Seat-availability subscriptions. Each watched course keeps its own
+// subscriber list and last known open/full state, so a seat change in a
+// course nobody watches costs one hash lookup. Filters are expanded into
+// the lists of the courses they match, including courses added later.
+//
+// Used on the registration system's writer thread. Callbacks run during the
+// change that triggered them: keep them short and do not call back into the
+// registration system.
+class SeatSubscriptions {
+public:
+    typedef uint64_t Id;
+    typedef std::function<void(const SeatNotice&)> Callback;
+
+private:
+    struct Subscriber {
+        Id id;
+        int day;         // -1: notified on whole-course changes, else on matching sections
+        Callback callback;
+    };
+
+    struct Watch {
+        std::vector<Subscriber> subscribers;
+        bool open = false;
+        std::vector<std::pair<std::string, bool>> sectionOpen;   // Section ID -> had a seat
+    };
+
+    struct FilterSubscription {
+        Id id;
+        SeatFilter filter;
+        Callback callback;
+    };
+
+    std::unordered_map<CourseCode, Watch> watches;
+    std::unordered_map<Id, std::vector<CourseCode>> coursesOf;   // Subscription -> watched courses
+    std::vector<FilterSubscription> filters;
+    Id nextId;
+
+    void attach(const Course& course, Id id, int day, const Callback& callback);
+
+public:
+    SeatSubscriptions();
+
+    Id subscribe(const Course& course, Callback callback);
+    Id subscribe(const SeatFilter& filter, const CourseStore& courses, Callback callback);
+    void unsubscribe(Id id);
+
+    // Call after anything that may change a course's seats or sections
+    void onSeatsChanged(const Course& course);
+    void onCourseAdded(const Course& course);
+    void onCourseRemoved(CourseCode code);
+
+    bool empty() const { return coursesOf.empty(); }
+    std::vector<CourseCode> watchedCourses() const;
+};
+
+#endif // SEAT_SUBSCRIPTIONS_H
@@ -0,0 +1,77 @@
+#ifndef SECTION_H
+#define SECTION_H
+
+#include "Keys.h"
+#include <string>
+#include <vector>
+
+// A single weekly meeting of a section (e.g. Monday 09:00 - 10:30)
+struct Meeting {
+    std::string dayOfWeek;
+    std::string startTime;
+    std::string endTime;
+
+    // Minutes since Monday 00:00, used for sorted interval comparisons
+    int weekStart;
+    int weekEnd;
+
+    Meeting();
+    Meeting(const std::string& dayOfWeek, const std::string& startTime, const std::string& endTime);
+
+    bool overlaps(const Meeting& other) const;
+
+    // Format: "Monday 09:00-10:30"
+    std::string toString() const;
+};
+
+// A section of a course: its own roster, capacity and weekly meetings
+class Section {
+private:
+    std::string sectionID;
+    int capacity;
+    std::vector<StudentId> enrolledStudentIDs;
+    std::vector<Meeting> meetings;  // Kept sorted by weekStart
+
+public:
+    Section();
+    Section(const std::string& sectionID, int capacity);
+    Section(const std::string& sectionID, int capacity, const std::vector<Meeting>& meetings);
+
+    const std::string& getSectionID() const;
+    int getCapacity() const;
+    int seatsRemaining() const;
+    const std::vector<StudentId>& getEnrolledStudentIDs() const;
+    const std::vector<Meeting>& getMeetings() const;
+
+    void setCapacity(int newCapacity);
+    void setMeetings(const std::vector<Meeting>& newMeetings);
+    void addMeeting(const Meeting& meeting);
+
+    bool isStudentEnrolled(StudentId studentID) const;
+    void enrollStudent(StudentId studentID, CourseCode courseCode);
+    void dropStudent(StudentId studentID, CourseCode courseCode);
+    // Bulk append for batch paths; caller has already checked seats and duplicates
+    void appendRoster(const std::vector<StudentId>& studentIDs);
+    // Empties the roster (term rollover); meetings and capacity are kept
+    void clearRoster();
+
+    // Sorted-interval merge against another section's meetings
+    bool hasTimeConflict(const Section& other) const;
+
+    // Format: "Monday 09:00-10:30,Wednesday 09:00-10:30"
+    std::string scheduleString() const;
+
+    // Helpers shared by persistence and validation
+    static int dayIndex(const std::string& dayOfWeek);
+    static int timeToMinutes(const std::string& time);
+    static std::string dayName(int dayIndex);
+    static std::string minutesToTime(int minutes);
+    static std::vector<Meeting> parseMeetings(const std::string& spec);
+
+    // Returns the index of the first meeting in 'schedule' overlapping 'candidate', or -1.
+    // Both lists must be sorted by weekStart; runs in O(n + m).
+    static int findOverlap(const std::vector<Meeting>& schedule,
+                           const std::vector<Meeting>& candidate);
+};
+
+#endif // SECTION_H
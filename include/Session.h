@@ -0,0 +1,241 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename T = void>
+class SessionTask;
+
+// Shared by both promise forms: lazy start, and on completion control passes
+// straight back to the awaiting coroutine (no stack growth across a menu's
+// nested calls)
+struct SessionPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            std::coroutine_handle<> next = handle.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() { error = std::current_exception(); }
+};
+
+template <typename T>
+struct SessionPromise : SessionPromiseBase {
+    std::optional<T> value;
+    SessionTask<T> get_return_object();
+    void return_value(T result) { value = std::move(result); }
+};
+
+template <>
+struct SessionPromise<void> : SessionPromiseBase {
+    SessionTask<void> get_return_object();
+    void return_void() {}
+};
+
+// Coroutine for session logic. Starts when awaited; an exception thrown
+// inside is rethrown to the awaiting coroutine.
+template <typename T>
+class SessionTask {
+public:
+    typedef SessionPromise<T> promise_type;
+    typedef std::coroutine_handle<promise_type> Handle;
+
+private:
+    Handle handle;
+
+    friend class Session;
+
+public:
+    explicit SessionTask(Handle handle) : handle(handle) {}
+    SessionTask(SessionTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    SessionTask& operator=(SessionTask&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    SessionTask(const SessionTask&) = delete;
+    SessionTask& operator=(const SessionTask&) = delete;
+    ~SessionTask() {
+        if (handle) handle.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() {
+        if (handle.promise().error) std::rethrow_exception(handle.promise().error);
+        if constexpr (!std::is_void_v<T>) return std::move(*handle.promise().value);
+    }
+};
+
+template <typename T>
+SessionTask<T> SessionPromise<T>::get_return_object() {
+    return SessionTask<T>(std::coroutine_handle<SessionPromise<T>>::from_promise(*this));
+}
+
+inline SessionTask<void> SessionPromise<void>::get_return_object() {
+    return SessionTask<void>(std::coroutine_handle<SessionPromise<void>>::from_promise(*this));
+}
+
+class Session;
+
+// Runs session steps (from one input line to the next read) on a small
+// thread pool, or on the caller's thread with runPending() when it has no
+// threads. The registration system is single-writer, so steps hold one
+// shared lock while they run; output is handed to the frontend after the
+// lock is released. Other threads that modify the system (the admission
+// dispatcher) take the same lock.
+class SessionExecutor {
+private:
+    std::mutex queueMutex;
+    std::condition_variable wakeup;
+    std::deque<Session*> runnable;
+    bool stopping;
+    std::vector<std::thread> workers;
+    std::mutex engineMutex;
+
+    void runStep(Session& session);
+
+public:
+    explicit SessionExecutor(size_t threads = 0);
+    // Finishes the steps already queued, then stops the threads
+    ~SessionExecutor();
+    SessionExecutor(const SessionExecutor&) = delete;
+    SessionExecutor& operator=(const SessionExecutor&) = delete;
+
+    void schedule(Session& session);
+    // Runs queued steps on the calling thread until none is left; returns how many ran
+    size_t runPending();
+    // Blocks until a step is queued (for callers of runPending whose session is parked)
+    void waitForWork();
+
+    std::mutex& engineLock() { return engineMutex; }
+};
+
+// One client of the menus: a console, socket, pipe or scripted driver.
+// The frontend feeds input lines and receives output through the sink; the
+// session's coroutine suspends whenever it needs a line it does not have yet,
+// so a waiting session costs only its coroutine frames, not a thread.
+//
+// Destroy a session only after finished(), or before start().
+class Session {
+public:
+    typedef std::function<void(const std::string&)> OutputSink;
+
+    // co_await session.park() suspends until wake(); if wake() came first it
+    // does not suspend at all. Each park must be matched by exactly one wake.
+    class ParkAwaiter {
+    private:
+        Session& session;
+
+    public:
+        explicit ParkAwaiter(Session& session) : session(session) {}
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> awaiting);
+        void await_resume() {}
+    };
+
+    // co_await session.readLine() yields the next line ("" once input has ended)
+    class LineAwaiter {
+    private:
+        Session& session;
+
+    public:
+        explicit LineAwaiter(Session& session) : session(session) {}
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> awaiting);
+        std::string await_resume();
+    };
+
+private:
+    SessionExecutor& executor;
+    OutputSink sink;
+    std::ostringstream buffer;   // Written only by the running step
+
+    mutable std::mutex mutex;
+    std::condition_variable finishedSignal;
+    std::deque<std::string> lines;
+    std::string pendingOutput;
+    std::coroutine_handle<> resumePoint;
+    size_t stepsRunning;
+    bool closed;
+    bool inputEnded;
+    bool waiting;
+    bool parked;
+    bool woken;       // wake() arrived before park()
+    bool finishing;   // The coroutine has returned; done once its last step ends
+    bool done;
+    std::mutex flushMutex;   // Keeps sink calls in output order
+
+    SessionTask<> task;
+
+    friend class SessionExecutor;
+
+    SessionTask<> run(SessionTask<> body);
+    void stashOutput();   // Caller holds mutex
+    void beginStep();
+    void endStep();
+
+public:
+    Session(SessionExecutor& executor, OutputSink sink);
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    // Frontend side (any thread)
+    void start(SessionTask<> body);
+    void input(std::string line);
+    // End of input: reads waiting now or later return "" and set eof()
+    void close();
+    bool finished() const;
+    void waitUntilFinished();
+    // Suspended on a read; a frontend running the executor itself should only
+    // block for input then (otherwise the session is parked or runnable)
+    bool needsInput() const;
+    // Unprompted output (e.g. a seat notice raised by another session's
+    // step): delivered with the session's next output if a step is running,
+    // straight to the sink otherwise
+    void notify(const std::string& text);
+
+    // Session side (inside the coroutine)
+    std::ostream& out() { return buffer; }
+    LineAwaiter readLine() { return LineAwaiter(*this); }
+    LineAwaiter prompt(const std::string& label) {
+        buffer << label;
+        return LineAwaiter(*this);
+    }
+    bool eof() const;
+    // Suspends the session without holding the engine lock, e.g. while
+    // another thread runs a request for it; wake() (any thread) resumes it
+    ParkAwaiter park() { return ParkAwaiter(*this); }
+    void wake();
+    // Listing pager prompt; false if the user stops or input has ended
+    SessionTask<bool> askForMore();
+};
+
+#endif // SESSION_H
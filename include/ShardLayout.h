@@ -0,0 +1,85 @@
+#ifndef SHARD_LAYOUT_H
+#define SHARD_LAYOUT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Hash-partitioned file layout for one data file. With a single shard the
+// original path is used (students.txt); with N shards records are spread
+// over students.0.txt ... students.<N-1>.txt by a hash of their key.
+class ShardLayout {
+private:
+    std::string basePath;
+    size_t shardCount;
+
+public:
+    explicit ShardLayout(std::string basePath = "", size_t shardCount = 1)
+        : basePath(std::move(basePath)), shardCount(shardCount == 0 ? 1 : shardCount) {}
+
+    size_t count() const { return shardCount; }
+
+    // FNV-1a, so shard assignment is stable across builds and platforms
+    static uint64_t hashKey(std::string_view key) {
+        uint64_t hash = 1469598103934665603ULL;
+        for (unsigned char c : key) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    size_t shardOf(std::string_view key) const {
+        return shardCount == 1 ? 0 : static_cast<size_t>(hashKey(key) % shardCount);
+    }
+
+    std::string path(size_t shard) const {
+        if (shardCount == 1) return basePath;
+        size_t dot = basePath.find_last_of('.');
+        size_t slash = basePath.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+            return basePath + "." + std::to_string(shard);
+        }
+        return basePath.substr(0, dot) + "." + std::to_string(shard) + basePath.substr(dot);
+    }
+};
+
+// Runs task(shard) for every shard in [0, count) on up to hardware_concurrency
+// threads. Tasks must only touch state owned by their shard. The first
+// exception thrown by a task is rethrown once all threads have finished.
+template <typename Task>
+void forEachShard(size_t count, Task task) {
+    size_t workers = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    if (workers <= 1) {
+        for (size_t shard = 0; shard < count; ++shard) task(shard);
+        return;
+    }
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    std::vector<std::thread> pool;
+    for (size_t w = 0; w < workers; ++w) {
+        pool.emplace_back([&]() {
+            for (size_t shard = next++; shard < count; shard = next++) {
+                try {
+                    task(shard);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                }
+            }
+        });
+    }
+    for (auto& thread : pool) thread.join();
+    if (error) std::rethrow_exception(error);
+}
+
+#endif // SHARD_LAYOUT_H
@@ -0,0 +1,163 @@
+#ifndef SLAB_STORE_H
+#define SLAB_STORE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Handle to a record in a SlabStore. The generation detects use after the
+// slot has been freed and reused.
+struct SlabHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == UINT32_MAX; }
+    bool operator==(const SlabHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlabHandle& other) const { return !(*this == other); }
+};
+
+// Slab storage made of fixed-size pages. Records never move once created,
+// so raw pointers and references stay valid until the record is erased.
+// Insert and erase are O(1) through a free list of vacated slots.
+template <typename T, size_t PageSize = 256>
+class SlabStore {
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        uint32_t generation = 0;
+        uint32_t nextFree = UINT32_MAX;
+        bool live = false;
+
+        T* get() { return std::launder(reinterpret_cast<T*>(storage)); }
+        const T* get() const { return std::launder(reinterpret_cast<const T*>(storage)); }
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> pages;
+    uint32_t usedSlots = 0;        // Slots ever handed out (high-water mark)
+    uint32_t freeHead = UINT32_MAX;
+    size_t liveCount = 0;
+
+    Slot& slot(uint32_t index) { return pages[index / PageSize][index % PageSize]; }
+    const Slot& slot(uint32_t index) const { return pages[index / PageSize][index % PageSize]; }
+
+public:
+    SlabStore() {}
+    SlabStore(const SlabStore&) = delete;
+    SlabStore& operator=(const SlabStore&) = delete;
+    ~SlabStore() { clear(); }
+
+    template <typename... Args>
+    SlabHandle emplace(Args&&... args) {
+        uint32_t index;
+        if (freeHead != UINT32_MAX) {
+            index = freeHead;
+            freeHead = slot(index).nextFree;
+        } else {
+            if (usedSlots == pages.size() * PageSize) {
+                pages.emplace_back(new Slot[PageSize]);
+            }
+            index = usedSlots++;
+        }
+        Slot& s = slot(index);
+        new (s.storage) T(std::forward<Args>(args)...);
+        s.live = true;
+        s.nextFree = UINT32_MAX;
+        ++liveCount;
+        return SlabHandle{index, s.generation};
+    }
+
+    // Returns nullptr if the handle is stale or was never valid
+    T* get(SlabHandle handle) {
+        if (handle.index >= usedSlots) return nullptr;
+        Slot& s = slot(handle.index);
+        return (s.live && s.generation == handle.generation) ? s.get() : nullptr;
+    }
+    const T* get(SlabHandle handle) const {
+        return const_cast<SlabStore*>(this)->get(handle);
+    }
+
+    bool erase(SlabHandle handle) {
+        if (get(handle) == nullptr) return false;
+        Slot& s = slot(handle.index);
+        s.get()->~T();
+        s.live = false;
+        ++s.generation;
+        s.nextFree = freeHead;
+        freeHead = handle.index;
+        --liveCount;
+        return true;
+    }
+
+    void clear() {
+        for (uint32_t i = 0; i < usedSlots; ++i) {
+            Slot& s = slot(i);
+            if (s.live) {
+                s.get()->~T();
+                s.live = false;
+                ++s.generation;
+            }
+        }
+        // Keep the pages; rebuild the free list in index order
+        freeHead = UINT32_MAX;
+        for (uint32_t i = usedSlots; i > 0; --i) {
+            slot(i - 1).nextFree = freeHead;
+            freeHead = i - 1;
+        }
+        liveCount = 0;
+    }
+
+    size_t size() const { return liveCount; }
+    bool empty() const { return liveCount == 0; }
+
+    // Iterates live records in slot order
+    template <typename Store, typename Value>
+    class Iterator {
+    private:
+        Store* store;
+        uint32_t index;
+
+        void skipDead() {
+            while (index < store->usedSlots && !store->slot(index).live) ++index;
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        Iterator(Store* store, uint32_t index) : store(store), index(index) { skipDead(); }
+
+        Value& operator*() const { return *store->slot(index).get(); }
+        Value* operator->() const { return store->slot(index).get(); }
+        Iterator& operator++() { ++index; skipDead(); return *this; }
+        Iterator operator++(int) { Iterator copy = *this; ++*this; return copy; }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+
+        SlabHandle handle() const { return SlabHandle{index, store->slot(index).generation}; }
+        uint32_t slotIndex() const { return index; }
+    };
+
+    typedef Iterator<SlabStore, T> iterator;
+    typedef Iterator<const SlabStore, const T> const_iterator;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, usedSlots); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, usedSlots); }
+
+    // Resume iteration at a slot index previously taken from slotIndex()
+    iterator from(uint32_t slotIndex) { return iterator(this, std::min(slotIndex, usedSlots)); }
+    const_iterator from(uint32_t slotIndex) const { return const_iterator(this, std::min(slotIndex, usedSlots)); }
+};
+
+#endif // SLAB_STORE_H
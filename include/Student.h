@@ -2,51 +2,65 @@
 #define STUDENT_H
 
 #include "User.h"
+#include "SlabStore.h"
+#include "Keys.h"
 #include <vector>
 using namespace std;
 
 // Student class inherits from User
 class Student : public User {
 private:
-    string studentID;
+    StudentId studentID;
     string major;
     double gpa;
-    vector<string> enrolledCourses;  // List of course codes student is enrolled in
+    vector<CourseCode> enrolledCourses;  // Course codes the student is enrolled in
+    vector<CourseCode> completedCourses; // Courses finished in earlier terms (prerequisite checks)
 
 public:
     // Constructors
     Student();
     Student(string username, string password, string email, string name, 
-            string userID, string studentID, string major, double gpa);
+            string userID, StudentId studentID, string major, double gpa);
     
     // Destructor
     ~Student();
     
-    // Getters
-    string getStudentID() const;
-    string getMajor() const;
+    // Getters (keys are one word and returned by value; no copies of strings)
+    StudentId getStudentID() const;
+    const string& getMajor() const;
     double getGPA() const;
-    vector<string> getEnrolledCourses() const;
+    const vector<CourseCode>& getEnrolledCourses() const;
+    const vector<CourseCode>& getCompletedCourses() const;
     
     // Setters
-    void setStudentID(string studentID);
+    void setStudentID(StudentId studentID);
     void setMajor(string major);
     void setGPA(double gpa);
-    void setEnrolledCourses(const vector<string>& courses);
+    void setEnrolledCourses(vector<CourseCode> courses);
+    void setCompletedCourses(vector<CourseCode> courses);
     
     // Course management
-    void addCourse(string courseCode);
-    void removeCourse(string courseCode);
-    bool isEnrolledIn(string courseCode) const;
+    void addCourse(CourseCode courseCode);
+    void removeCourse(CourseCode courseCode);
+    // Replaces one enrolled course with another in place (no allocation)
+    void replaceCourse(CourseCode from, CourseCode to);
+    bool isEnrolledIn(CourseCode courseCode) const;
     int getTotalEnrolledCourses() const;
     
+    // Completed-course history
+    void addCompletedCourse(CourseCode courseCode);
+    bool hasCompleted(CourseCode courseCode) const;
+    
     // Override virtual functions from User (Polymorphism!)
-    void displayMenu() override;
+    void displayMenu(ostream& out = cout) override;
     string getUserType() const override;
     
     // Student-specific display
-    void displayStudentInfo() const;
-    void displayEnrolledCourses() const;
+    void displayStudentInfo(ostream& out = cout) const;
+    void displayEnrolledCourses(ostream& out = cout) const;
 };
 
+// Stable-address storage for student records
+typedef SlabStore<Student> StudentStore;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef STUDENT_DIRECTORY_H
+#define STUDENT_DIRECTORY_H
+
+#include "ShardLayout.h"
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Where a student's line starts in the shard files
+struct StudentLocation {
+    uint32_t shard;
+    uint64_t offset;
+};
+
+// Index for lazy student loading. Usernames and student IDs are kept only as
+// 64-bit hashes mapped to (shard, byte offset), under 50 bytes per student,
+// so a hash hit is a candidate the caller confirms against the loaded line.
+// Also tracks which loaded (resident) records are least recently used.
+class StudentDirectory {
+private:
+    struct Entry {
+        uint64_t hash;
+        uint32_t shard;
+        uint64_t offset;
+
+        bool operator<(const Entry& other) const { return hash < other.hash; }
+    };
+
+    std::vector<Entry> byUsername;    // Sorted by hash
+    std::vector<Entry> byStudentID;   // Sorted by hash
+
+    // Resident records by slab slot: most recently used at the front
+    std::list<uint32_t> recency;
+    std::unordered_map<uint32_t, std::list<uint32_t>::iterator> recencyPosition;
+    std::unordered_map<uint32_t, int> pinCount;   // Resident slots that have been pinned; 0 = released
+    std::unordered_set<uint32_t> dirtySlots;
+
+    static std::vector<StudentLocation> find(const std::vector<Entry>& entries, uint64_t hash);
+
+public:
+    // Scans the shard files in parallel, hashing only the username and ID
+    // fields, and replaces the index; the resident working set is kept.
+    // Lines whose student ID does not fit a StudentId are left out; returns
+    // how many.
+    size_t build(const ShardLayout& layout);
+    void clear();
+    size_t size() const { return byUsername.size(); }
+    // The i-th indexed line (i < size()), in an order that holds until the
+    // index next changes; for paging through every student
+    StudentLocation locationAt(size_t i) const { return StudentLocation{byUsername[i].shard, byUsername[i].offset}; }
+
+    // Replaces one shard's entries after it was rewritten
+    // (lines = username, student ID and offset of every line in the new file)
+    struct LineInfo {
+        std::string username;
+        std::string studentID;
+        uint64_t offset;
+    };
+    void replaceShard(uint32_t shard, const std::vector<LineInfo>& lines);
+
+    std::vector<StudentLocation> findUsername(const std::string& username) const;
+    std::vector<StudentLocation> findStudentID(const std::string& studentID) const;
+
+    // Reads the line starting at a location
+    static bool readLine(const ShardLayout& layout, const StudentLocation& location, std::string& line);
+    // Username and student ID fields of a students.txt line
+    static LineInfo lineKeys(const std::string& line, uint64_t offset);
+
+    // ---- Resident working set ----
+    void touch(uint32_t slot);
+    void forget(uint32_t slot);
+    void pin(uint32_t slot);
+    void unpin(uint32_t slot);
+    void markDirty(uint32_t slot);
+    bool isDirty(uint32_t slot) const { return dirtySlots.count(slot) != 0; }
+    void clearDirty(uint32_t slot) { dirtySlots.erase(slot); }
+    // Least recently used slot that is neither pinned nor dirty; false if none
+    bool evictionCandidate(uint32_t& slot) const;
+};
+
+#endif // STUDENT_DIRECTORY_H
@@ -0,0 +1,34 @@
+#ifndef TERM_ARCHIVE_H
+#define TERM_ARCHIVE_H
+
+#include "Course.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Catalog and rosters of a past term. Loaded from the term's archive file the
+// first time it is asked for, then only read.
+class TermArchive {
+private:
+    std::string termID;
+    CourseStore courses;
+    std::unordered_map<CourseCode, SlabHandle> courseIndex;                 // Course code -> handle
+    std::unordered_map<StudentId, std::vector<CourseCode>> studentCourses;  // Student ID -> course codes
+
+    // RegistrationSystem parses the archive file into the store
+    friend class RegistrationSystem;
+    void buildIndexes();
+
+public:
+    explicit TermArchive(std::string termID);
+
+    const std::string& getTermID() const { return termID; }
+    const CourseStore& getCourses() const { return courses; }
+    const Course* getCourse(std::string_view code) const;
+
+    // Courses the student was enrolled in that term (empty if none)
+    const std::vector<CourseCode>& coursesOf(StudentId studentID) const;
+};
+
+#endif // TERM_ARCHIVE_H
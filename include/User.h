@@ -1,6 +1,7 @@
 #ifndef USER_H
 #define USER_H
 
+#include <iostream>
 #include <string>
 using namespace std;
 
@@ -14,19 +15,19 @@ protected:
     string userID;
 
 public:
-    // Constructor
+    // Constructor (sink parameters are moved into place)
     User();
     User(string username, string password, string email, string name, string userID);
     
     // Virtual Destructor (important for base classes)
     virtual ~User();
     
-    // Getters
-    string getUsername() const;
-    string getPassword() const;
-    string getEmail() const;
-    string getName() const;
-    string getUserID() const;
+    // Getters (return references; no copies)
+    const string& getUsername() const;
+    const string& getPassword() const;
+    const string& getEmail() const;
+    const string& getName() const;
+    const string& getUserID() const;
     
     // Setters
     void setUsername(string username);
@@ -35,11 +36,11 @@ public:
     void setName(string name);
     
     // Virtual functions (to be overridden by derived classes)
-    virtual void displayMenu() = 0;  // Pure virtual - makes User abstract
+    virtual void displayMenu(ostream& out = cout) = 0;  // Pure virtual - makes User abstract
     virtual string getUserType() const = 0;  // Returns "STUDENT" or "ADMIN"
     
     // Display user info
-    void displayInfo() const;
+    void displayInfo(ostream& out = cout) const;
 };
 
 #endif
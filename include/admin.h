@@ -4,6 +4,8 @@
 #include "User.h"
 #include "Course.h"
 #include "Student.h"
+#include "RegistrationSystem.h"
+#include "Session.h"
 #include <vector>
 #include <string>
 
@@ -17,20 +19,47 @@ public:
     Admin(string username, string password, string email, string name, string userID);
 
     // POLYMORPHISM: Override pure virtual functions from User
-    void displayMenu() override;
+    void displayMenu(ostream& out = cout) override;
     string getUserType() const override;
     
-    // Admin-specific course management functions
-    void addCourse(vector<Course>& courses, const Course& newCourse);
-    bool removeCourse(vector<Course>& courses, const string& courseCode);
-    bool modifyCourse(vector<Course>& courses, const string& courseCode);
-    void viewAllCourses(const vector<Course>& courses) const;
+    // Admin-specific course management functions (edit the live catalog in place)
+    void addCourse(RegistrationSystem& regSys, const Course& newCourse, ostream& out = cout);
+    // Enrolled students lose the course; alternativeCode (may be empty) is offered to them
+    bool removeCourse(RegistrationSystem& regSys, const string& courseCode, const string& alternativeCode,
+                      ostream& out = cout);
+    
+    // Interactive operations run inside a session and suspend while waiting for input
+    SessionTask<bool> modifyCourse(Session& session, RegistrationSystem& regSys, const string& courseCode);
+    SessionTask<> viewAllCourses(Session& session, const RegistrationSystem& regSys) const;
     
     // View enrolled students in a specific course
-    void viewCourseEnrollments(const vector<Course>& courses, const string& courseCode) const;
+    SessionTask<> viewCourseEnrollments(Session& session, const RegistrationSystem& regSys,
+                                        const string& courseCode) const;
     
     // View all students in the system
-    void viewAllStudents(const vector<Student>& students) const;
+    SessionTask<> viewAllStudents(Session& session, const RegistrationSystem& regSys) const;
+    
+    // Enrollment analytics report, optionally saved to a file
+    SessionTask<> viewEnrollmentAnalytics(Session& session, const RegistrationSystem& regSys) const;
+    
+    // Export catalog, rosters or students to CSV / JSON Lines in the background
+    SessionTask<> exportData(Session& session, RegistrationSystem& regSys) const;
+    
+    // Terms: archive the active term and open a new one; browse archived terms
+    SessionTask<> rolloverTerm(Session& session, RegistrationSystem& regSys) const;
+    SessionTask<> viewPastTerm(Session& session, const RegistrationSystem& regSys) const;
+    
+    // Prerequisite / corequisite relations of a course
+    SessionTask<> editPrerequisites(Session& session, RegistrationSystem& regSys) const;
+    
+    // Lists the registration rules in force and reloads rules.txt on request
+    SessionTask<> manageRules(Session& session, RegistrationSystem& regSys) const;
+    
+    // Enrollment history log: events by student or course, seat holders at a time
+    SessionTask<> viewEnrollmentLog(Session& session, const RegistrationSystem& regSys) const;
+    
+    // Enroll students selected by major, ID range or list file into a course (and its lab)
+    SessionTask<> enrollCohort(Session& session, RegistrationSystem& regSys) const;
     
     // Serialize for file I/O
     string serialize() const;
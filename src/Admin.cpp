@@ -1,9 +1,12 @@
 #include "../include/Admin.h"
 #include "../include/CustomExceptions.h"
+#include "../include/InputValidator.h"
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <sstream>
+#include <utility>
 
 using namespace std;
 
@@ -11,7 +14,7 @@ using namespace std;
 Admin::Admin() : User() {}
 
 Admin::Admin(string username, string password, string email, string name, string userID) 
-    : User(username, password, email, name, userID) {}
+    : User(std::move(username), std::move(password), std::move(email), std::move(name), std::move(userID)) {}
 
 // POLYMORPHISM: Override getUserType
 string Admin::getUserType() const {
@@ -19,202 +22,462 @@ string Admin::getUserType() const {
 }
 
 // POLYMORPHISM: Override displayMenu - shows admin menu
-void Admin::displayMenu() {
-    cout << "\n========================================\n";
-    cout << "          ADMIN MENU                   \n";
-    cout << "========================================\n";
-    cout << " 1. Add Course\n";
-    cout << " 2. Remove Course\n";
-    cout << " 3. Modify Course\n";
-    cout << " 4. View All Courses\n";
-    cout << " 5. View Course Enrollments\n";
-    cout << " 6. View All Students\n";
-    cout << " 7. View My Info\n";
-    cout << " 8. Logout\n";
-    cout << "========================================\n";
-    cout << "Enter your choice: ";
+void Admin::displayMenu(ostream& out) {
+    out << "\n========================================\n";
+    out << "          ADMIN MENU                   \n";
+    out << "========================================\n";
+    out << " 1. Add Course\n";
+    out << " 2. Remove Course\n";
+    out << " 3. Modify Course\n";
+    out << " 4. View All Courses\n";
+    out << " 5. View Course Enrollments\n";
+    out << " 6. View All Students\n";
+    out << " 7. View My Info\n";
+    out << " 8. Logout\n";
+    out << " 9. Open Seat Allocation Window\n";
+    out << "10. Close Window and Allocate Seats\n";
+    out << "11. Enrollment Analytics\n";
+    out << "12. Export Data (CSV / JSON Lines)\n";
+    out << "13. Term Rollover\n";
+    out << "14. View Past Term\n";
+    out << "15. Edit Prerequisites\n";
+    out << "16. Registration Rules\n";
+    out << "17. Enrollment History Log\n";
+    out << "18. Enroll a Cohort\n";
+    out << "========================================\n";
+    out << "Enter your choice: ";
 }
 
 // Add a new course to the system
-void Admin::addCourse(vector<Course>& courses, const Course& newCourse) {
-    // Check if course code already exists
-    for (const auto& course : courses) {
-        if (course.getCode() == newCourse.getCode()) {
-            throw RegistrationException("Course code already exists: " + newCourse.getCode());
-        }
-    }
-    
-    courses.push_back(newCourse);
-    cout << "\n✓ Course added successfully: " << newCourse.getCode() 
-         << " - " << newCourse.getTitle() << endl;
+void Admin::addCourse(RegistrationSystem& regSys, const Course& newCourse, ostream& out) {
+    RegistrationSystem::ActorScope actor(regSys, getUserID());
+    regSys.addCourse(newCourse);
+    out << "\n✓ Course added successfully: " << newCourse.getCode() 
+        << " - " << newCourse.getTitle() << endl;
 }
 
-// Remove a course from the system
-bool Admin::removeCourse(vector<Course>& courses, const string& courseCode) {
-    auto it = remove_if(courses.begin(), courses.end(),
-        [&courseCode](const Course& c) {
-            return c.getCode() == courseCode;
-        });
-    
-    if (it != courses.end()) {
-        courses.erase(it, courses.end());
-        cout << "\n✓ Course removed successfully: " << courseCode << endl;
-        return true;
-    }
-    
-    throw RegistrationException("Course not found: " + courseCode);
+// Remove a course from the system and from every enrolled student
+bool Admin::removeCourse(RegistrationSystem& regSys, const string& courseCode, const string& alternativeCode,
+                         ostream& out) {
+    RegistrationSystem::ActorScope actor(regSys, getUserID());
+    CancellationReport report = regSys.removeCourse(courseCode, alternativeCode);
+    out << "\n✓ Course removed successfully: " << courseCode << endl;
+    report.print(out);
+    return true;
 }
 
 // Modify an existing course
-bool Admin::modifyCourse(vector<Course>& courses, const string& courseCode) {
-    // Find the course
-    Course* courseToModify = nullptr;
-    for (auto& course : courses) {
-        if (course.getCode() == courseCode) {
-            courseToModify = &course;
-            break;
+// Capacity and meeting edits: shows who the change affects and, if anyone,
+// asks how to resolve them. The change is re-checked when applied, so
+// registrations made meanwhile by other sessions are accounted for.
+static SessionTask<bool> changeSchedule(Session& session, RegistrationSystem& regSys, const string& userID,
+                                    const string& courseCode, const string& sectionID, const ScheduleChange& change) {
+    ostream& out = session.out();
+    ScheduleImpact impact = regSys.analyzeScheduleChange(courseCode, sectionID, change);
+    ImpactResolution resolution = ImpactResolution::KeepConflicts;
+    if (!impact.affected.empty()) {
+        impact.print(out);
+        out << "Students over capacity are moved to an open section, or dropped if there is none.\n";
+        if (impact.overCapacity > 0 && impact.conflicts > 0) {
+            out << "Counts assume conflicts keep their seat; moving them first leaves fewer over capacity.\n";
+        }
+        out << "Students with a new conflict: 1. Keep their seat  2. Move them, else keep  "
+               "3. Move them, else drop  0. Cancel the change\n";
+        string choice = co_await session.prompt("Choice: ");
+        if (choice == "2") resolution = ImpactResolution::MoveOrKeep;
+        else if (choice == "3") resolution = ImpactResolution::MoveOrDrop;
+        else if (choice != "1") {
+            out << "Modification cancelled.\n";
+            co_return false;
         }
     }
-    
+    RegistrationSystem::ActorScope actor(regSys, userID);
+    impact = regSys.applyScheduleChange(courseCode, sectionID, change, resolution);
+    if (impact.affected.empty()) out << "✓ Updated; no enrolled student is affected.\n";
+    else impact.print(out);
+    co_return true;
+}
+
+SessionTask<bool> Admin::modifyCourse(Session& session, RegistrationSystem& regSys, const string& courseCode) {
+    ostream& out = session.out();
+    // Find the course (read-only; edits go through RegistrationSystem)
+    const Course* courseToModify = regSys.getCourse(courseCode);
     if (!courseToModify) {
         throw RegistrationException("Course not found: " + courseCode);
     }
     
-    cout << "\n=== Modify Course: " << courseCode << " ===\n";
-    cout << "Current course name: " << courseToModify->getTitle() << endl;
+    out << "\n=== Modify Course: " << courseCode << " ===\n";
+    out << "Current course name: " << courseToModify->getTitle() << endl;
+    
+    // Capacity and schedule edits apply to a single section
+    string sectionID;
+    if (courseToModify->getSections().size() > 1) {
+        out << "Sections:";
+        for (const auto& section : courseToModify->getSections()) {
+            out << " " << section.getSectionID();
+        }
+        sectionID = co_await session.prompt("\nSection to modify (blank for first): ");
+    }
     
-    int choice;
-    cout << "\nWhat would you like to modify?\n";
-    cout << "1. Course Title\n";
-    cout << "2. Capacity\n";
-    cout << "3. Schedule (Day and Time)\n";
-    cout << "0. Cancel\n";
-    cout << "Choice: ";
-    cin >> choice;
-    cin.ignore();
+    out << "\nWhat would you like to modify?\n";
+    out << "1. Course Title\n";
+    out << "2. Capacity\n";
+    out << "3. Schedule (Day and Time)\n";
+    out << "4. Meetings (multiple per week)\n";
+    out << "5. Add Section\n";
+    out << "6. Cancel Section (students lose their seat)\n";
+    out << "0. Cancel\n";
+    int choice = InputValidator::parseInteger(co_await session.prompt("Choice: "));
     
     switch (choice) {
         case 1: {
-            string newTitle;
-            cout << "Enter new course title: ";
-            getline(cin, newTitle);
-            courseToModify->setCourseName(newTitle);
-            cout << "✓ Course title updated.\n";
+            string newTitle = co_await session.prompt("Enter new course title: ");
+            RegistrationSystem::ActorScope actor(regSys, getUserID());
+            regSys.setCourseTitle(courseCode, newTitle);
+            out << "✓ Course title updated.\n";
             break;
         }
         case 2: {
-            int newCapacity;
-            cout << "Enter new capacity: ";
-            cin >> newCapacity;
-            courseToModify->setCapacity(newCapacity);
-            cout << "✓ Capacity updated.\n";
+            int newCapacity = InputValidator::parseInteger(co_await session.prompt("Enter new capacity: "));
+            if (!InputValidator::isValidCapacity(newCapacity)) {
+                throw InvalidInputException("capacity", to_string(newCapacity), "must be between 1 and 500");
+            }
+            ScheduleChange change;
+            change.capacity = newCapacity;
+            if (!co_await changeSchedule(session, regSys, getUserID(), courseCode, sectionID, change)) co_return false;
             break;
         }
         case 3: {
-            string newDay, newStartTime, newEndTime;
-            cout << "Enter new day (e.g., Monday): ";
-            getline(cin, newDay);
-            cout << "Enter new start time (HH:MM): ";
-            getline(cin, newStartTime);
-            cout << "Enter new end time (HH:MM): ";
-            getline(cin, newEndTime);
+            string newDay = co_await session.prompt("Enter new day (e.g., Monday): ");
+            string newStartTime = co_await session.prompt("Enter new start time (HH:MM): ");
+            string newEndTime = co_await session.prompt("Enter new end time (HH:MM): ");
             
-            courseToModify->setSchedule(newDay, newStartTime, newEndTime);
-            cout << "✓ Schedule updated.\n";
+            if (!InputValidator::isValidMeeting(newDay, newStartTime, newEndTime)) {
+                throw InvalidInputException("schedule", newDay + " " + newStartTime + "-" + newEndTime,
+                                            "expected a weekday and HH:MM start before end");
+            }
+            ScheduleChange change;
+            change.changeMeetings = true;
+            change.meetings = {Meeting(newDay, newStartTime, newEndTime)};
+            if (!co_await changeSchedule(session, regSys, getUserID(), courseCode, sectionID, change)) co_return false;
+            break;
+        }
+        case 4: {
+            string spec = co_await session.prompt("Enter meetings (e.g., Monday 09:00-10:30,Wednesday 09:00-10:30): ");
+            if (!InputValidator::isValidMeetingList(spec)) {
+                throw InvalidInputException("meetings", spec, "expected 'Day HH:MM-HH:MM' entries that do not overlap");
+            }
+            ScheduleChange change;
+            change.changeMeetings = true;
+            change.meetings = Section::parseMeetings(spec);
+            if (!co_await changeSchedule(session, regSys, getUserID(), courseCode, sectionID, change)) co_return false;
+            break;
+        }
+        case 5: {
+            string newSectionID = co_await session.prompt("Enter new section ID (e.g., 002): ");
+            int newCapacity = InputValidator::parseInteger(co_await session.prompt("Enter capacity: "));
+            string spec = co_await session.prompt("Enter meetings (e.g., Monday 09:00-10:30,Wednesday 09:00-10:30): ");
+            if (!InputValidator::isValidSectionID(newSectionID)) {
+                throw InvalidInputException("section ID", newSectionID, "expected 1-4 letters or digits");
+            }
+            if (!InputValidator::isValidCapacity(newCapacity)) {
+                throw InvalidInputException("capacity", to_string(newCapacity), "must be between 1 and 500");
+            }
+            if (!spec.empty() && !InputValidator::isValidMeetingList(spec)) {
+                throw InvalidInputException("meetings", spec, "expected 'Day HH:MM-HH:MM' entries that do not overlap");
+            }
+            RegistrationSystem::ActorScope actor(regSys, getUserID());
+            regSys.addCourseSection(courseCode, Section(newSectionID, newCapacity, Section::parseMeetings(spec)));
+            out << "✓ Section added.\n";
+            break;
+        }
+        case 6: {
+            if (sectionID.empty()) {
+                sectionID = co_await session.prompt("Section to cancel: ");
+            }
+            string alternativeCode = co_await session.prompt("Offer displaced students (course code, "
+                                                             "same code for another section, blank for none): ");
+            RegistrationSystem::ActorScope actor(regSys, getUserID());
+            CancellationReport report = regSys.cancelSection(courseCode, sectionID, alternativeCode);
+            report.print(out);
             break;
         }
         case 0:
-            cout << "Modification cancelled.\n";
-            return false;
+            out << "Modification cancelled.\n";
+            co_return false;
         default:
-            cout << "Invalid choice.\n";
-            return false;
+            out << "Invalid choice.\n";
+            co_return false;
     }
     
-    return true;
+    co_return true;
 }
 
+// Listings are paged so large catalogs and rosters stay usable over a terminal
+static const size_t PAGE_SIZE = 20;
+
 // View all courses in the system
-void Admin::viewAllCourses(const vector<Course>& courses) const {
-    if (courses.empty()) {
-        cout << "\nNo courses available in the system.\n";
-        return;
-    }
-    
-    cout << "\n========================================\n";
-    cout << "          ALL COURSES IN SYSTEM        \n";
-    cout << "========================================\n";
-    
-    for (const auto& course : courses) {
-        cout << "Code: " << course.getCode() << endl;
-        cout << "Title: " << course.getTitle() << endl;
-        cout << "Capacity: " << course.getCapacity() 
-             << " | Enrolled: " << course.getEnrolledStudentIDs().size()
-             << " | Remaining: " << course.seatsRemaining() << endl;
-        if (!course.getDayOfWeek().empty()) {
-            cout << "Schedule: " << course.getDayOfWeek() 
-                 << " " << course.getStartTime() 
-                 << " - " << course.getEndTime() << endl;
-        }
-        cout << "----------------------------------------\n";
+SessionTask<> Admin::viewAllCourses(Session& session, const RegistrationSystem& regSys) const {
+    ListingCursor cursor;
+    do {
+        regSys.renderCatalogPage(CatalogStyle::Admin, cursor, PAGE_SIZE, session.out());
+    } while (!cursor.done && co_await session.askForMore());
+}
+
+// View students enrolled in a specific course
+SessionTask<> Admin::viewCourseEnrollments(Session& session, const RegistrationSystem& regSys,
+                                           const string& courseCode) const {
+    ListingCursor cursor;
+    do {
+        regSys.renderRosterPage(courseCode, cursor, PAGE_SIZE, session.out());
+    } while (!cursor.done && co_await session.askForMore());
+}
+
+// View all students in the system
+SessionTask<> Admin::viewAllStudents(Session& session, const RegistrationSystem& regSys) const {
+    ListingCursor cursor;
+    do {
+        regSys.renderStudentsPage(cursor, PAGE_SIZE, session.out());
+    } while (!cursor.done && co_await session.askForMore());
+}
+
+// Enrollment analytics (computed in parallel), to the session and optionally a file
+SessionTask<> Admin::viewEnrollmentAnalytics(Session& session, const RegistrationSystem& regSys) const {
+    ostream& out = session.out();
+    AnalyticsReport report = regSys.computeAnalytics();
+    report.print(out);
+    
+    string path = co_await session.prompt("Save report to file (blank to skip): ");
+    if (path.empty()) co_return;
+    
+    ofstream file(path);
+    if (!file.is_open()) {
+        throw FileException(path, "write");
+    }
+    report.print(file);
+    out << "✓ Report saved to " << path << endl;
+}
+
+// Export: prompts for what to write, snapshots it and writes the file in the background
+SessionTask<> Admin::exportData(Session& session, RegistrationSystem& regSys) const {
+    ostream& out = session.out();
+    ExportOptions options;
+    
+    out << "\n--- Export Data ---\n";
+    string choice = co_await session.prompt("Export: 1. Catalog (sections)  2. Rosters  3. Students\nChoice: ");
+    if (choice == "2") options.entity = ExportEntity::Rosters;
+    else if (choice == "3") options.entity = ExportEntity::Students;
+    
+    choice = co_await session.prompt("Format: 1. CSV  2. JSON Lines\nChoice: ");
+    if (choice == "2") options.format = ExportFormat::JSONLines;
+    
+    out << "Available fields:";
+    for (const auto& field : DataExporter::availableFields(options.entity)) {
+        out << " " << field;
+    }
+    string fields = co_await session.prompt("\nFields (comma-separated, blank for all): ");
+    stringstream fieldStream(fields);
+    string field;
+    while (getline(fieldStream, field, ',')) {
+        field.erase(0, field.find_first_not_of(' '));
+        field.erase(field.find_last_not_of(' ') + 1);
+        if (!field.empty()) options.fields.push_back(field);
+    }
+    
+    if (options.entity != ExportEntity::Catalog) {
+        options.major = co_await session.prompt("Only major (blank for all): ");
     }
+    options.courseCode = co_await session.prompt("Only course code (blank for all): ");
     
-    cout << "Total Courses: " << courses.size() << endl;
+    string path = co_await session.prompt("Output file: ");
+    if (path.empty()) {
+        out << "Export cancelled.\n";
+        co_return;
+    }
+    
+    size_t rows = regSys.startExport(options, path);
+    out << "✓ Exporting " << rows << " rows to " << path << " in the background.\n";
 }
 
-// View students enrolled in a specific course
-void Admin::viewCourseEnrollments(const vector<Course>& courses, const string& courseCode) const {
-    // Find the course
-    const Course* targetCourse = nullptr;
-    for (const auto& course : courses) {
-        if (course.getCode() == courseCode) {
-            targetCourse = &course;
-            break;
-        }
+// Archive the active term and open a new one with empty rosters
+SessionTask<> Admin::rolloverTerm(Session& session, RegistrationSystem& regSys) const {
+    ostream& out = session.out();
+    out << "\n--- Term Rollover ---\n";
+    out << "Active term: " << regSys.getActiveTerm() << endl;
+    string newTerm = co_await session.prompt("New term ID (e.g., 2027-SPRING): ");
+    if (!InputValidator::isValidTermID(newTerm)) {
+        throw InvalidInputException("term ID", newTerm, "expected 1-12 letters, digits or dashes");
     }
     
-    if (!targetCourse) {
-        throw RegistrationException("Course not found: " + courseCode);
+    out << "Archive " << regSys.getActiveTerm() << " and clear all current enrollments? (y/n): ";
+    string confirm = co_await session.readLine();
+    if (confirm != "y" && confirm != "Y") {
+        out << "Rollover cancelled.\n";
+        co_return;
     }
     
-    cout << "\n=== Enrollments for Course: " << courseCode << " ===\n";
-    cout << "Course Title: " << targetCourse->getTitle() << endl;
-    cout << "Enrolled Students: " << targetCourse->getEnrolledStudentIDs().size() 
-         << " / " << targetCourse->getCapacity() << endl;
-    cout << "----------------------------------------\n";
+    string archived = regSys.getActiveTerm();
+    RegistrationSystem::ActorScope actor(regSys, getUserID());
+    regSys.rolloverTerm(newTerm);
+    out << "✓ Term " << archived << " archived. Active term is now " << newTerm << ".\n";
+}
+
+// Read-only catalog and rosters of an archived term, loaded on first view
+SessionTask<> Admin::viewPastTerm(Session& session, const RegistrationSystem& regSys) const {
+    ostream& out = session.out();
+    const auto& terms = regSys.getArchivedTerms();
+    if (terms.empty()) {
+        out << "\nNo archived terms yet.\n";
+        co_return;
+    }
+    out << "\nArchived terms:";
+    for (const auto& termID : terms) {
+        out << " " << termID;
+    }
+    string termID = co_await session.prompt("\nTerm to view: ");
     
-    const auto& enrolledIDs = targetCourse->getEnrolledStudentIDs();
-    if (enrolledIDs.empty()) {
-        cout << "No students enrolled yet.\n";
-    } else {
-        for (size_t i = 0; i < enrolledIDs.size(); i++) {
-            cout << (i + 1) << ". Student ID: " << enrolledIDs[i] << endl;
-        }
+    const TermArchive& term = regSys.getArchivedTerm(termID);
+    out << "\n=== Term " << term.getTermID() << " ===";
+    ListingRenderer renderer;
+    ListingCursor cursor;
+    do {
+        renderer.renderCatalogPage(term.getCourses(), CatalogStyle::Admin, cursor, PAGE_SIZE, out);
+    } while (!cursor.done && co_await session.askForMore());
+}
+
+// Shows a course's relations and applies one edit; cycles are rejected by the system
+SessionTask<> Admin::editPrerequisites(Session& session, RegistrationSystem& regSys) const {
+    ostream& out = session.out();
+    out << "\n--- Edit Prerequisites ---\n";
+    string code = co_await session.prompt("Course code: ");
+    const Course* course = regSys.getCourse(code);
+    if (!course) {
+        throw RegistrationException("Course not found: " + code);
+    }
+    
+    const PrerequisiteGraph& graph = regSys.getPrerequisites();
+    auto printCodes = [&out](const string& label, const vector<CourseCode>& codes) {
+        out << label << ":";
+        if (codes.empty()) out << " (none)";
+        for (const auto& c : codes) out << " " << c;
+        out << endl;
+    };
+    printCodes("Prerequisites", graph.prerequisitesOf(course->getCode()));
+    printCodes("All required (incl. indirect)", graph.allPrerequisitesOf(course->getCode()));
+    printCodes("Corequisites", graph.corequisitesOf(course->getCode()));
+    
+    out << "1. Add Prerequisite  2. Remove Prerequisite  3. Add Corequisite  4. Remove Corequisite\n";
+    string action = co_await session.prompt("Choice (blank to leave unchanged): ");
+    if (action != "1" && action != "2" && action != "3" && action != "4") {
+        out << "No changes made.\n";
+        co_return;
     }
+    string other = co_await session.prompt("Other course code: ");
+    
+    if (action == "1") regSys.addPrerequisite(code, other);
+    else if (action == "2") regSys.removePrerequisite(code, other);
+    else if (action == "3") regSys.addCorequisite(code, other);
+    else regSys.removeCorequisite(code, other);
+    out << "✓ Relations for " << code << " updated.\n";
 }
 
-// View all students in the system
-void Admin::viewAllStudents(const vector<Student>& students) const {
-    if (students.empty()) {
-        cout << "\nNo students in the system.\n";
-        return;
+SessionTask<> Admin::manageRules(Session& session, RegistrationSystem& regSys) const {
+    ostream& out = session.out();
+    auto printRules = [&regSys, &out]() {
+        const RuleSet& rules = regSys.getRules();
+        out << "\n--- Registration Rules (" << rules.size() << ") ---\n";
+        if (rules.empty()) out << "No rules in force.\n";
+        for (size_t i = 0; i < rules.size(); ++i) {
+            out << setw(3) << (i + 1) << ". " << rules.ruleName(i) << ": " << rules.ruleText(i) << endl;
+        }
+    };
+    printRules();
+    
+    string confirm = co_await session.prompt("Reload rules.txt? (y/n): ");
+    if (confirm != "y" && confirm != "Y") co_return;
+    regSys.reloadRules();
+    out << "✓ Rules reloaded.\n";
+    printRules();
+}
+
+// Enrollment history: a student's or course's events over recent days, or
+// who held seats in a course at a given time
+SessionTask<> Admin::viewEnrollmentLog(Session& session, const RegistrationSystem& regSys) const {
+    ostream& out = session.out();
+    out << "\n--- Enrollment History Log ---\n";
+    out << "1. Events for a Student  2. Events for a Course  3. Seat Holders at a Time\n";
+    string choice = co_await session.prompt("Choice: ");
+    
+    if (choice == "3") {
+        string code = co_await session.prompt("Course code: ");
+        string when = co_await session.prompt("Time (YYYY-MM-DD HH:MM:SS): ");
+        int64_t time = 0;
+        if (!EnrollmentLog::parseTime(when, time)) {
+            throw InvalidInputException("time", when, "expected YYYY-MM-DD HH:MM:SS");
+        }
+        vector<StudentId> holders = regSys.seatHoldersAt(code, time);
+        out << "Seats in " << code << " at " << when << ": " << holders.size() << endl;
+        for (const auto& id : holders) out << "  " << id << endl;
+        co_return;
+    }
+    if (choice != "1" && choice != "2") {
+        out << "Invalid choice.\n";
+        co_return;
     }
     
-    cout << "\n========================================\n";
-    cout << "          ALL STUDENTS IN SYSTEM       \n";
-    cout << "========================================\n";
+    EventQuery query;
+    string key = co_await session.prompt(choice == "1" ? "Student ID: " : "Course code: ");
+    bool valid = choice == "1" ? StudentId::tryParse(key, query.student) : CourseCode::tryParse(key, query.course);
+    if (!valid) {
+        throw InvalidInputException(choice == "1" ? "student ID" : "course code", key, "not a valid key");
+    }
+    int days = InputValidator::parseInteger(co_await session.prompt("Days back (blank for 7): "), 7);
+    if (days < 1) {
+        throw InvalidInputException("days", to_string(days), "must be at least 1");
+    }
+    query.from = EnrollmentLog::now() - static_cast<int64_t>(days) * 86400 * 1000000;
     
-    for (const auto& student : students) {
-        cout << "Name: " << student.getName() << endl;
-        cout << "Username: " << student.getUsername() << endl;
-        cout << "Student ID: " << student.getStudentID() << endl;
-        cout << "Major: " << student.getMajor() << endl;
-        cout << "GPA: " << fixed << setprecision(2) << student.getGPA() << endl;
-        cout << "Enrolled Courses: " << student.getTotalEnrolledCourses() << endl;
-        cout << "----------------------------------------\n";
+    vector<EnrollmentEvent> events = regSys.getEnrollmentLog().find(query);
+    out << events.size() << " event(s) for " << key << " in the last " << days << " day(s)\n";
+    for (const auto& event : events) {
+        EnrollmentLog::print(out, event);
     }
+}
+
+SessionTask<> Admin::enrollCohort(Session& session, RegistrationSystem& regSys) const {
+    ostream& out = session.out();
+    out << "\n--- Enroll a Cohort ---\n";
+    string codeList = co_await session.prompt("Course codes, comma separated (e.g., IC101,IC102): ");
+    vector<string> codes;
+    stringstream codeStream(codeList);
+    string code;
+    while (getline(codeStream, code, ',')) {
+        code.erase(0, code.find_first_not_of(' '));
+        code.erase(code.find_last_not_of(' ') + 1);
+        if (!code.empty()) codes.push_back(code);
+    }
+    
+    CohortSelector selector;
+    string listPath = co_await session.prompt("Student ID list file (blank to select by major / ID range): ");
+    if (!listPath.empty()) selector.studentIDs = CohortSelector::readIdFile(listPath);
+    selector.major = co_await session.prompt("Major (blank for any): ");
+    selector.fromID = co_await session.prompt("Student IDs from (e.g., S1000, blank for no lower bound): ");
+    selector.toID = co_await session.prompt("Student IDs to (blank for no upper bound): ");
     
-    cout << "Total Students: " << students.size() << endl;
+    CohortPolicy policy;
+    out << "If seats run short: 1. Seat as many as fit  2. Enroll nobody\n";
+    if (co_await session.prompt("Choice: ") == "2") policy.fill = CohortFill::AllOrNothing;
+    out << "Seated first: 1. Class Year  2. GPA  3. Lottery\n";
+    string priorityChoice = co_await session.prompt("Choice: ");
+    if (priorityChoice == "2") policy.priority = PriorityPolicy::GPA;
+    else if (priorityChoice == "3") policy.priority = PriorityPolicy::LotteryOnly;
+    
+    CohortReport report;
+    {
+        RegistrationSystem::ActorScope actor(regSys, getUserID());
+        report = regSys.enrollCohort(selector, codes, policy);
+    }
+    report.print(out);
 }
 
 // Serialize admin data for file I/O
@@ -235,5 +498,5 @@ Admin Admin::deserialize(const string& data) {
     getline(ss, uid, '|');
     getline(ss, type, '|');
     
-    return Admin(user, pass, mail, nm, uid);
+    return Admin(std::move(user), std::move(pass), std::move(mail), std::move(nm), std::move(uid));
 }
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "../include/AdmissionController.h"
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+
+namespace {
+
+std::future<RegistrationResult> readyResult(RegistrationResult result, const std::function<void()>& onReady) {
+    std::promise<RegistrationResult> promise;
+    promise.set_value(std::move(result));
+    if (onReady) onReady();
+    return promise.get_future();
+}
+
+} // namespace
+
+AdmissionController::AdmissionController(RegistrationSystem& regSys, std::mutex& engineLock,
+                                         const AdmissionPolicy& policy)
+    : regSys(regSys), engineLock(engineLock), policy(policy), queued(0), stopping(false), waitTotalMs(0.0),
+      waitHistogram{}, serviceAverageUs(0.0) {
+    for (size_t w = 0; w < std::max<size_t>(policy.workers, 1); ++w) {
+        dispatchers.emplace_back([this]() { dispatch(); });
+    }
+}
+
+AdmissionController::~AdmissionController() {
+    shutdown();
+}
+
+void AdmissionController::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto& dispatcher : dispatchers) {
+        if (dispatcher.joinable()) dispatcher.join();
+    }
+}
+
+std::future<RegistrationResult> AdmissionController::submitRegister(Student& student, const std::string& courseCode,
+                                                                    const std::string& sectionID,
+                                                                    std::function<void()> onReady) {
+    return submit(Kind::Register, student, courseCode, courseCode, "", sectionID, std::move(onReady));
+}
+
+std::future<RegistrationResult> AdmissionController::submitDrop(Student& student, const std::string& courseCode,
+                                                                std::function<void()> onReady) {
+    return submit(Kind::Drop, student, courseCode, courseCode, "", "", std::move(onReady));
+}
+
+std::future<RegistrationResult> AdmissionController::submitSwap(Student& student, const std::string& fromCode,
+                                                                const std::string& toCode,
+                                                                const std::string& toSectionID,
+                                                                std::function<void()> onReady) {
+    return submit(Kind::Swap, student, toCode, fromCode, toCode, toSectionID, std::move(onReady));
+}
+
+// Everything queued runs before a retry could, one request at a time
+uint32_t AdmissionController::estimatedWaitMs() const {
+    double ms = static_cast<double>(queued + 1) * serviceAverageUs / 1000.0;
+    return static_cast<uint32_t>(std::max(1.0, ms));
+}
+
+std::future<RegistrationResult> AdmissionController::submit(Kind kind, Student& student,
+                                                            const std::string& queueCode,
+                                                            const std::string& courseCode,
+                                                            const std::string& toCode,
+                                                            const std::string& sectionID,
+                                                            std::function<void()> onReady) {
+    RegistrationResult rejection;
+    rejection.courseCode = queueCode;
+    rejection.sectionID = sectionID;
+
+    // Text that cannot be a course code is not found, as in the engine
+    CourseCode key;
+    if (!CourseCode::tryParse(queueCode, key)) {
+        rejection.status = RegistrationStatus::CourseNotFound;
+        return readyResult(std::move(rejection), onReady);
+    }
+
+    StudentId studentID = student.getStudentID();
+    std::unique_lock<std::mutex> lock(mutex);
+    ++counters.submitted;
+
+    size_t& studentPending = pending[studentID];
+    auto& queue = queues[key];
+    bool full = stopping || queued >= policy.maxQueued || queue.size() >= policy.maxQueuedPerCourse;
+    if (full || studentPending >= policy.maxPendingPerStudent) {
+        if (full) ++counters.rejectedQueueFull;
+        else ++counters.rejectedStudentLimit;
+        if (studentPending == 0) pending.erase(studentID);
+        if (queue.empty()) queues.erase(key);
+        rejection.status = RegistrationStatus::TryLater;
+        rejection.retryAfterMs = estimatedWaitMs();
+        lock.unlock();
+        return readyResult(std::move(rejection), onReady);
+    }
+
+    ++studentPending;
+    if (queue.empty() && running.count(key) == 0) rotation.push_back(key);
+    queue.push_back(Request{kind, &student, studentID, courseCode, toCode, sectionID,
+                            std::chrono::steady_clock::now(), std::promise<RegistrationResult>(),
+                            std::move(onReady)});
+    std::future<RegistrationResult> result = queue.back().promise.get_future();
+    ++queued;
+    counters.maxQueued = std::max(counters.maxQueued, queued);
+    lock.unlock();
+    wakeup.notify_one();
+    return result;
+}
+
+RegistrationResult AdmissionController::execute(Request& request) {
+    std::lock_guard<std::mutex> lock(engineLock);
+    switch (request.kind) {
+        case Kind::Register:
+            return regSys.tryRegisterForCourse(*request.student, request.courseCode, request.sectionID);
+        case Kind::Drop:
+            return regSys.tryDropCourse(*request.student, request.courseCode);
+        case Kind::Swap:
+            return regSys.trySwapCourse(*request.student, request.courseCode, request.toCode, request.sectionID);
+    }
+    return RegistrationResult();
+}
+
+void AdmissionController::dispatch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeup.wait(lock, [this]() { return stopping || !rotation.empty(); });
+        if (rotation.empty()) return;   // Stopping and drained
+
+        // One request from the course at the front, which goes to the back
+        // once it ends, so no two of a course's requests run together
+        CourseCode key = rotation.front();
+        rotation.pop_front();
+        auto queueIt = queues.find(key);
+        Request request = std::move(queueIt->second.front());
+        queueIt->second.pop_front();
+        if (queueIt->second.empty()) queues.erase(queueIt);
+        running.insert(key);
+        --queued;
+        lock.unlock();
+
+        auto started = std::chrono::steady_clock::now();
+        RegistrationResult result;
+        std::exception_ptr error;
+        try {
+            result = execute(request);
+        } catch (...) {
+            error = std::current_exception();   // e.g. a file error while loading a record
+        }
+        auto finished = std::chrono::steady_clock::now();
+
+        lock.lock();
+        double waitUs = std::chrono::duration<double, std::micro>(started - request.submitted).count();
+        double serviceUs = std::chrono::duration<double, std::micro>(finished - started).count();
+        ++counters.completed;
+        waitTotalMs += waitUs / 1000.0;
+        counters.maxWaitMs = std::max(counters.maxWaitMs, waitUs / 1000.0);
+        size_t bucket = std::bit_width(static_cast<uint64_t>(waitUs));
+        ++waitHistogram[std::min(bucket, WAIT_BUCKETS - 1)];
+        serviceAverageUs = serviceAverageUs == 0.0 ? serviceUs : serviceAverageUs + (serviceUs - serviceAverageUs) / 16;
+        auto pendingIt = pending.find(request.studentID);
+        if (--pendingIt->second == 0) pending.erase(pendingIt);
+        running.erase(key);
+        if (queues.count(key) != 0) {
+            rotation.push_back(key);
+            wakeup.notify_one();
+        }
+
+        if (error) request.promise.set_exception(error);
+        else request.promise.set_value(std::move(result));
+        if (request.onReady) {
+            lock.unlock();
+            request.onReady();
+            lock.lock();
+        }
+    }
+}
+
+AdmissionMetrics AdmissionController::metrics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    AdmissionMetrics snapshot = counters;
+    snapshot.queued = queued;
+    snapshot.activeCourses = queues.size();
+    snapshot.meanServiceUs = serviceAverageUs;
+    if (counters.completed > 0) {
+        snapshot.meanWaitMs = waitTotalMs / static_cast<double>(counters.completed);
+        uint64_t target = counters.completed - counters.completed / 100;   // 99% of waits at or below
+        uint64_t seen = 0;
+        for (size_t b = 0; b < WAIT_BUCKETS; ++b) {
+            seen += waitHistogram[b];
+            if (seen >= target) {
+                snapshot.p99WaitMs = static_cast<double>(uint64_t(1) << b) / 1000.0;
+                break;
+            }
+        }
+    }
+    for (const auto& entry : queues) snapshot.deepestQueues.emplace_back(entry.first, entry.second.size());
+    std::sort(snapshot.deepestQueues.begin(), snapshot.deepestQueues.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+    if (snapshot.deepestQueues.size() > 5) snapshot.deepestQueues.resize(5);
+    return snapshot;
+}
+
+void AdmissionMetrics::print(std::ostream& out) const {
+    out << "\n========================================\n";
+    out << "          ADMISSION CONTROL             \n";
+    out << "========================================\n";
+    out << "Submitted: " << submitted << " | Completed: " << completed
+        << " | Rejected (queue full): " << rejectedQueueFull
+        << " | Rejected (student limit): " << rejectedStudentLimit << "\n";
+    out << "Queued now: " << queued << " in " << activeCourses << " courses | High-water mark: " << maxQueued << "\n";
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(2)
+        << "Wait ms: mean " << meanWaitMs << " | p99 <= " << p99WaitMs << " | max " << maxWaitMs
+        << " | Service: " << meanServiceUs << " us/request\n";
+    out.unsetf(std::ios::floatfield);
+    out.precision(precision);
+    for (const auto& entry : deepestQueues) {
+        out << "  " << std::left << std::setw(10) << entry.first << entry.second << " waiting\n";
+    }
+}
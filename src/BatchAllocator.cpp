@@ -0,0 +1,387 @@
+#include "../include/BatchAllocator.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+typedef std::pair<int, int> Interval;  // [weekStart, weekEnd) in minutes
+
+enum FailReason { NONE, NOT_FOUND, FULL, CONFLICT, ALREADY_ENROLLED, RULE };
+
+const char* reasonText(int reason) {
+    switch (reason) {
+        case NOT_FOUND: return "course or section not found";
+        case FULL: return "no seats available";
+        case CONFLICT: return "time conflict";
+        case ALREADY_ENROLLED: return "already enrolled";
+        case RULE: return "rejected by rule";
+        default: return "";
+    }
+}
+
+// Both lists sorted by start; advance whichever interval ends first
+bool overlapsSorted(const std::vector<Interval>& a, const std::vector<Interval>& b) {
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i].first < b[j].second && a[i].second > b[j].first) return true;
+        if (a[i].second <= b[j].second) ++i; else ++j;
+    }
+    return false;
+}
+
+// Numeric part of a student ID such as S12345; used as a cohort proxy
+long studentNumber(StudentId studentID) {
+    long value = 0;
+    for (char ch : studentID.view()) {
+        if (std::isdigit(static_cast<unsigned char>(ch))) value = value * 10 + (ch - '0');
+    }
+    return value;
+}
+
+} // namespace
+
+BatchAllocator::BatchAllocator(CourseStore& courses, StudentStore& students, const AllocationPolicy& policy,
+                               const RuleSet* rules)
+    : courseStore(courses), studentStore(students), policy(policy), rules(rules) {}
+
+AllocationReport BatchAllocator::run(const std::vector<SeatRequest>& requests) {
+    // Dense views of the stores; records have stable addresses for the whole run
+    std::vector<Course*> courses;
+    std::vector<Student*> students;
+    courses.reserve(courseStore.size());
+    students.reserve(studentStore.size());
+    for (auto& course : courseStore) courses.push_back(&course);
+    for (auto& student : studentStore) students.push_back(&student);
+
+    const int studentCount = static_cast<int>(students.size());
+    const int courseCount = static_cast<int>(courses.size());
+
+    // ---- Index students, courses and sections ----
+    std::unordered_map<StudentId, int> studentIndex;
+    studentIndex.reserve(students.size());
+    for (int s = 0; s < studentCount; ++s) {
+        studentIndex.emplace(students[s]->getStudentID(), s);
+    }
+
+    std::unordered_map<CourseCode, int> courseIndex;
+    courseIndex.reserve(courses.size());
+    std::vector<int> sectionBegin(courseCount + 1, 0);
+    for (int c = 0; c < courseCount; ++c) {
+        courseIndex.emplace(courses[c]->getCode(), c);
+        sectionBegin[c + 1] = sectionBegin[c] + static_cast<int>(courses[c]->getSections().size());
+    }
+
+    const int sectionCount = sectionBegin[courseCount];
+    std::vector<int> seatsLeft(sectionCount);
+    std::vector<std::vector<Interval>> sectionTimes(sectionCount);
+    std::vector<std::vector<Interval>> schedule(studentCount);
+    std::vector<std::vector<int>> enrolledIn(studentCount);
+
+    for (int c = 0; c < courseCount; ++c) {
+        const auto& sections = courses[c]->getSections();
+        for (size_t k = 0; k < sections.size(); ++k) {
+            int sec = sectionBegin[c] + static_cast<int>(k);
+            seatsLeft[sec] = sections[k].seatsRemaining();
+            for (const auto& meeting : sections[k].getMeetings()) {
+                sectionTimes[sec].emplace_back(meeting.weekStart, meeting.weekEnd);
+            }
+            // Seed each student's existing schedule from the rosters
+            for (const auto& id : sections[k].getEnrolledStudentIDs()) {
+                auto it = studentIndex.find(id);
+                if (it == studentIndex.end()) continue;
+                enrolledIn[it->second].push_back(c);
+                schedule[it->second].insert(schedule[it->second].end(),
+                                            sectionTimes[sec].begin(), sectionTimes[sec].end());
+            }
+        }
+    }
+    for (auto& times : schedule) {
+        std::sort(times.begin(), times.end());
+    }
+
+    // Rule inputs that do not change per candidate; credits grow as seats are allocated
+    const bool checkRules = rules != nullptr && !rules->empty();
+    std::vector<double> courseCredits;
+    std::vector<double> studentCredits;
+    std::vector<double> completedCredits;
+    double registrationDay = 0.0;
+    if (checkRules) {
+        courseCredits.resize(courseCount);
+        for (int c = 0; c < courseCount; ++c) courseCredits[c] = rules->creditsOf(courses[c]->getCode());
+        studentCredits.assign(studentCount, 0.0);
+        completedCredits.assign(studentCount, 0.0);
+        for (int s = 0; s < studentCount; ++s) {
+            for (int c : enrolledIn[s]) studentCredits[s] += courseCredits[c];
+            for (const auto& code : students[s]->getCompletedCourses()) completedCredits[s] += rules->creditsOf(code);
+        }
+        registrationDay = rules->registrationDay();
+    }
+
+    // ---- Flatten requests: choices stored as global section index, -1 any, -2 unknown ----
+    const int requestCount = static_cast<int>(requests.size());
+    std::vector<int> requestStudent(requestCount);
+    std::vector<int> choiceBegin(requestCount + 1, 0);
+    std::vector<int> choiceCourse;
+    std::vector<int> choiceSection;
+
+    for (int r = 0; r < requestCount; ++r) {
+        StudentId id;
+        auto st = StudentId::tryParse(requests[r].studentID, id) ? studentIndex.find(id) : studentIndex.end();
+        requestStudent[r] = st == studentIndex.end() ? -1 : st->second;
+        for (const auto& choice : requests[r].rankedChoices) {
+            CourseCode code;
+            auto ct = CourseCode::tryParse(choice.courseCode, code) ? courseIndex.find(code) : courseIndex.end();
+            int course = ct == courseIndex.end() ? -1 : ct->second;
+            int section = -1;
+            if (course >= 0 && !choice.sectionID.empty()) {
+                section = -2;
+                const auto& sections = courses[course]->getSections();
+                for (size_t k = 0; k < sections.size(); ++k) {
+                    if (sections[k].getSectionID() == choice.sectionID) {
+                        section = sectionBegin[course] + static_cast<int>(k);
+                        break;
+                    }
+                }
+            }
+            choiceCourse.push_back(section == -2 ? -1 : course);
+            choiceSection.push_back(section);
+        }
+        choiceBegin[r + 1] = static_cast<int>(choiceCourse.size());
+    }
+
+    // Requests grouped per student in submission order (CSR layout)
+    std::vector<int> queueBegin(studentCount + 1, 0);
+    for (int r = 0; r < requestCount; ++r) {
+        if (requestStudent[r] >= 0) ++queueBegin[requestStudent[r] + 1];
+    }
+    for (int s = 0; s < studentCount; ++s) queueBegin[s + 1] += queueBegin[s];
+    std::vector<int> queue(queueBegin[studentCount]);
+    {
+        std::vector<int> fill(queueBegin.begin(), queueBegin.end() - 1);
+        for (int r = 0; r < requestCount; ++r) {
+            if (requestStudent[r] >= 0) queue[fill[requestStudent[r]]++] = r;
+        }
+    }
+
+    // ---- Rank students once: policy key, then seeded lottery number ----
+    std::vector<double> priority(studentCount, 0.0);
+    std::vector<uint64_t> lottery(studentCount);
+    std::mt19937_64 rng(policy.seed);
+    for (int s = 0; s < studentCount; ++s) {
+        lottery[s] = rng();
+        if (policy.priority == PriorityPolicy::GPA) {
+            priority[s] = students[s]->getGPA();
+        } else if (policy.priority == PriorityPolicy::ClassYear) {
+            priority[s] = -static_cast<double>(studentNumber(students[s]->getStudentID()));
+        }
+    }
+    std::vector<int> order(studentCount);
+    for (int s = 0; s < studentCount; ++s) order[s] = s;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        if (priority[a] != priority[b]) return priority[a] > priority[b];
+        return lottery[a] < lottery[b];
+    });
+    std::vector<uint32_t> rank(studentCount);
+    for (int i = 0; i < studentCount; ++i) rank[order[i]] = static_cast<uint32_t>(i);
+
+    // ---- Draft passes ----
+    std::vector<int> cursor(queueBegin.begin(), queueBegin.end() - 1);  // Next request per student
+    std::vector<int> currentChoice(requestCount, 0);
+    std::vector<int> assignedSection(requestCount, -1);
+    std::vector<int> failReason(requestCount, NONE);
+    std::vector<int> failRule(requestCount, -1);
+    std::vector<std::pair<uint64_t, int>> candidates;
+    candidates.reserve(studentCount);
+
+    unsigned workerCount = policy.threads ? policy.threads : std::thread::hardware_concurrency();
+    if (workerCount == 0) workerCount = 1;
+
+    // Resolves one candidate; only touches that student's state and the course's seats
+    auto resolve = [&](int r) {
+        int s = requestStudent[r];
+        int idx = choiceBegin[r] + currentChoice[r];
+        int course = choiceCourse[idx];
+        int wanted = choiceSection[idx];
+
+        int reason = NONE;
+        if (std::find(enrolledIn[s].begin(), enrolledIn[s].end(), course) != enrolledIn[s].end()) {
+            reason = ALREADY_ENROLLED;
+        } else {
+            int first = wanted >= 0 ? wanted : sectionBegin[course];
+            int last = wanted >= 0 ? wanted + 1 : sectionBegin[course + 1];
+            reason = FULL;
+            RuleContext context;
+            if (checkRules) {
+                context.gpa = students[s]->getGPA();
+                context.credits = studentCredits[s] + courseCredits[course];
+                context.courses = static_cast<double>(enrolledIn[s].size() + 1);
+                context.completedCredits = completedCredits[s];
+                context.day = registrationDay;
+                context.major = students[s]->getMajor();
+                context.course = courses[course]->getCode();
+            }
+            for (int sec = first; sec < last; ++sec) {
+                if (seatsLeft[sec] <= 0) continue;
+                if (checkRules) {
+                    context.section = courses[course]->getSections()[sec - sectionBegin[course]].getSectionID();
+                    int violated = rules->firstViolation(context);
+                    if (violated >= 0) {
+                        if (reason != CONFLICT) reason = RULE;
+                        failRule[r] = violated;
+                        continue;
+                    }
+                }
+                if (overlapsSorted(schedule[s], sectionTimes[sec])) {
+                    reason = CONFLICT;
+                    continue;
+                }
+                --seatsLeft[sec];
+                std::vector<Interval> merged;
+                merged.reserve(schedule[s].size() + sectionTimes[sec].size());
+                std::merge(schedule[s].begin(), schedule[s].end(),
+                           sectionTimes[sec].begin(), sectionTimes[sec].end(), std::back_inserter(merged));
+                schedule[s].swap(merged);
+                enrolledIn[s].push_back(course);
+                if (checkRules) studentCredits[s] += courseCredits[course];
+                assignedSection[r] = sec;
+                reason = NONE;
+                break;
+            }
+        }
+
+        if (reason == NONE) {
+            ++cursor[s];
+            return;
+        }
+        failReason[r] = reason;
+        if (++currentChoice[r] >= choiceBegin[r + 1] - choiceBegin[r]) {
+            ++cursor[s];  // Out of alternates
+        }
+    };
+
+    while (true) {
+        candidates.clear();
+        for (int s = 0; s < studentCount; ++s) {
+            while (cursor[s] < queueBegin[s + 1]) {
+                int r = queue[cursor[s]];
+                int count = choiceBegin[r + 1] - choiceBegin[r];
+                // Skip choices that can never succeed without using a pass
+                while (currentChoice[r] < count && choiceCourse[choiceBegin[r] + currentChoice[r]] < 0) {
+                    failReason[r] = NOT_FOUND;
+                    ++currentChoice[r];
+                }
+                if (currentChoice[r] < count) {
+                    uint64_t course = static_cast<uint64_t>(choiceCourse[choiceBegin[r] + currentChoice[r]]);
+                    candidates.emplace_back((course << 32) | rank[s], r);
+                    break;
+                }
+                ++cursor[s];
+            }
+        }
+        if (candidates.empty()) break;
+
+        std::sort(candidates.begin(), candidates.end());
+
+        // Boundaries of each course's run of candidates
+        std::vector<size_t> runs;
+        runs.push_back(0);
+        for (size_t i = 1; i < candidates.size(); ++i) {
+            if ((candidates[i].first >> 32) != (candidates[i - 1].first >> 32)) runs.push_back(i);
+        }
+        runs.push_back(candidates.size());
+
+        std::atomic<size_t> nextRun(0);
+        auto worker = [&]() {
+            for (size_t run = nextRun++; run + 1 < runs.size(); run = nextRun++) {
+                for (size_t i = runs[run]; i < runs[run + 1]; ++i) {
+                    resolve(candidates[i].second);
+                }
+            }
+        };
+
+        unsigned threads = std::min<unsigned>(workerCount, static_cast<unsigned>(runs.size() - 1));
+        if (threads <= 1) {
+            worker();
+        } else {
+            std::vector<std::thread> pool;
+            for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+            for (auto& thread : pool) thread.join();
+        }
+    }
+
+    // ---- Apply admissions ----
+    std::vector<std::vector<StudentId>> newRoster(sectionCount);
+    std::vector<int> sectionCourse(sectionCount);
+    for (int c = 0; c < courseCount; ++c) {
+        for (int sec = sectionBegin[c]; sec < sectionBegin[c + 1]; ++sec) sectionCourse[sec] = c;
+    }
+    for (int r = 0; r < requestCount; ++r) {
+        int sec = assignedSection[r];
+        if (sec < 0) continue;
+        int s = requestStudent[r];
+        newRoster[sec].push_back(students[s]->getStudentID());
+        students[s]->addCourse(courses[sectionCourse[sec]]->getCode());
+    }
+    for (int c = 0; c < courseCount; ++c) {
+        const auto& sections = courses[c]->getSections();
+        for (size_t k = 0; k < sections.size(); ++k) {
+            int sec = sectionBegin[c] + static_cast<int>(k);
+            if (newRoster[sec].empty()) continue;
+            courses[c]->findSection(sections[k].getSectionID())->appendRoster(newRoster[sec]);
+        }
+    }
+
+    // ---- Report ----
+    AllocationReport report;
+    report.outcomes.reserve(requestCount);
+    for (int r = 0; r < requestCount; ++r) {
+        AllocationOutcome outcome;
+        outcome.studentID = requests[r].studentID;
+        int sec = assignedSection[r];
+        if (sec >= 0) {
+            int c = sectionCourse[sec];
+            outcome.assignedCourse = courses[c]->getCode();
+            outcome.sectionID = courses[c]->getSections()[sec - sectionBegin[c]].getSectionID();
+            outcome.choiceRank = currentChoice[r];
+            ++report.admitted;
+            if (currentChoice[r] == 0) ++report.firstChoice;
+        } else {
+            outcome.choiceRank = -1;
+            outcome.reason = requestStudent[r] < 0 ? "unknown student"
+                           : requests[r].rankedChoices.empty() ? "no choices given"
+                           : failReason[r] == RULE ? "rejected by rule '" + rules->ruleName(failRule[r]) + "'"
+                           : reasonText(failReason[r]);
+            ++report.unplaced;
+        }
+        report.outcomes.push_back(std::move(outcome));
+    }
+    std::stable_sort(report.outcomes.begin(), report.outcomes.end(),
+        [](const AllocationOutcome& a, const AllocationOutcome& b) { return a.studentID < b.studentID; });
+    return report;
+}
+
+void AllocationReport::print(std::ostream& out) const {
+    out << "\n========================================\n";
+    out << "        SEAT ALLOCATION RESULTS         \n";
+    out << "========================================\n";
+    for (const auto& outcome : outcomes) {
+        out << std::left << std::setw(10) << outcome.studentID;
+        if (outcome.choiceRank >= 0) {
+            out << "-> " << outcome.assignedCourse << " section " << outcome.sectionID
+                << " (choice " << (outcome.choiceRank + 1) << ")\n";
+        } else {
+            out << "-> unplaced: " << outcome.reason << "\n";
+        }
+    }
+    out << "----------------------------------------\n";
+    out << "Requests: " << outcomes.size()
+        << " | Admitted: " << admitted
+        << " | First choice: " << firstChoice
+        << " | Unplaced: " << unplaced << "\n";
+}
@@ -0,0 +1,240 @@
+#include "../include/CatalogSnapshot.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+const Course* CatalogSnapshot::find(std::string_view code) const {
+    CourseCode key;
+    if (!CourseCode::tryParse(code, key)) return nullptr;
+    auto it = index->find(key);
+    return it == index->end() ? nullptr : &at(it->second);
+}
+
+CatalogReader& CatalogReader::operator=(CatalogReader&& other) noexcept {
+    if (this != &other) {
+        release();
+        slot = other.slot;
+        snapshot = other.snapshot;
+        other.slot = nullptr;
+    }
+    return *this;
+}
+
+void CatalogReader::release() {
+    if (slot) slot->store(0, std::memory_order_release);
+    slot = nullptr;
+}
+
+SnapshotPublisher::SnapshotPublisher() {
+    current.store(new CatalogSnapshot());
+}
+
+SnapshotPublisher::~SnapshotPublisher() {
+    for (auto& entry : retired) delete entry.second;
+    for (CatalogSnapshot* spare : spareVersions) delete spare;
+    delete current.load();
+}
+
+CatalogReader SnapshotPublisher::read() const {
+    // Start each thread at its own slot so readers rarely collide
+    static thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+    for (size_t attempt = 0;; ++attempt) {
+        ReaderSlot& slot = slots[(hint + attempt) % READER_SLOTS];
+        uint64_t expected = 0;
+        // Announcing an epoch that is already stale only delays reclamation
+        if (slot.epoch.compare_exchange_strong(expected, epoch.load())) {
+            hint = (hint + attempt) % READER_SLOTS;
+            return CatalogReader(&slot.epoch, current.load());
+        }
+        if (attempt % READER_SLOTS == READER_SLOTS - 1) std::this_thread::yield();
+    }
+}
+
+uint64_t SnapshotPublisher::currentVersion() const {
+    return current.load()->version;
+}
+
+CatalogSnapshot* SnapshotPublisher::nextVersion() {
+    const CatalogSnapshot* previous = current.load(std::memory_order_relaxed);
+    CatalogSnapshot* next;
+    if (spareVersions.empty()) {
+        next = new CatalogSnapshot(*previous);   // Shares chunks and index
+    } else {
+        next = spareVersions.back();
+        spareVersions.pop_back();
+        *next = *previous;   // Reuses the chunk list's capacity
+    }
+    next->version = previous->version + 1;
+    return next;
+}
+
+void SnapshotPublisher::publish(CatalogSnapshot* next) {
+    CatalogSnapshot* previous = const_cast<CatalogSnapshot*>(current.exchange(next));
+    // A reader that announces a later epoch is guaranteed to load next
+    uint64_t replacedIn = epoch.fetch_add(1);
+    retired.emplace_back(replacedIn, previous);
+    for (auto& chunk : replacedChunks) retiredChunks.emplace_back(replacedIn, std::move(chunk));
+    for (auto& course : replacedCourses) retiredCourses.emplace_back(replacedIn, std::move(course));
+    replacedChunks.clear();
+    replacedCourses.clear();
+    reclaim();
+}
+
+void SnapshotPublisher::reclaim() {
+    uint64_t oldestPinned = UINT64_MAX;
+    for (const auto& slot : slots) {
+        uint64_t pinned = slot.epoch.load();
+        if (pinned != 0 && pinned < oldestPinned) oldestPinned = pinned;
+    }
+    size_t kept = 0;
+    for (auto& entry : retired) {
+        if (entry.first < oldestPinned) {
+            entry.second->chunks.clear();   // Drops its references; capacity stays for reuse
+            entry.second->index.reset();
+            spareVersions.push_back(entry.second);
+        } else {
+            retired[kept++] = entry;
+        }
+    }
+    retired.resize(kept);
+
+    // Replaced chunks and courses are free once the versions that held them are
+    kept = 0;
+    for (auto& entry : retiredChunks) {
+        if (entry.first >= oldestPinned) {
+            retiredChunks[kept++] = std::move(entry);
+        } else if (entry.second.use_count() == 1) {
+            auto chunk = std::const_pointer_cast<CatalogSnapshot::Chunk>(std::move(entry.second));
+            chunk->clear();   // Lets go of its courses so they can be reused below
+            spareChunks.push_back(std::move(chunk));
+        }
+    }
+    retiredChunks.resize(kept);
+    kept = 0;
+    for (auto& entry : retiredCourses) {
+        if (entry.first >= oldestPinned) {
+            retiredCourses[kept++] = std::move(entry);
+        } else if (entry.second.use_count() == 1) {
+            spareCourses.push_back(std::const_pointer_cast<Course>(std::move(entry.second)));
+        }
+    }
+    retiredCourses.resize(kept);
+}
+
+void SnapshotPublisher::publishAll(const CourseStore& courses) {
+    CatalogSnapshot* next = nextVersion();
+    auto index = std::make_shared<CatalogSnapshot::Index>();
+    index->reserve(courses.size());
+    next->chunks.clear();
+    next->count = 0;
+
+    std::shared_ptr<CatalogSnapshot::Chunk> chunk;
+    for (const auto& course : courses) {
+        if (next->count % CatalogSnapshot::CHUNK_SIZE == 0) {
+            if (chunk) next->chunks.push_back(std::move(chunk));
+            chunk = std::make_shared<CatalogSnapshot::Chunk>();
+            chunk->reserve(CatalogSnapshot::CHUNK_SIZE);
+        }
+        chunk->push_back({std::make_shared<const Course>(course), next->version});
+        index->emplace(course.getCode(), static_cast<uint32_t>(next->count++));
+    }
+    if (chunk) next->chunks.push_back(std::move(chunk));
+    next->index = std::move(index);
+    publish(next);
+}
+
+CatalogSnapshot::Chunk& SnapshotPublisher::ownChunk(CatalogSnapshot& next, size_t at) {
+    const CatalogSnapshot* previous = current.load(std::memory_order_relaxed);
+    const auto& shared = next.chunks[at];
+    if (at >= previous->chunks.size() || shared != previous->chunks[at]) {
+        // Already copied for this version; no reader can see it yet
+        return const_cast<CatalogSnapshot::Chunk&>(*shared);
+    }
+    std::shared_ptr<CatalogSnapshot::Chunk> copy;
+    if (spareChunks.empty()) {
+        copy = std::make_shared<CatalogSnapshot::Chunk>();
+        copy->reserve(CatalogSnapshot::CHUNK_SIZE);
+    } else {
+        copy = std::move(spareChunks.back());
+        spareChunks.pop_back();
+    }
+    *copy = *shared;
+    replacedChunks.push_back(shared);
+    next.chunks[at] = copy;
+    return *copy;
+}
+
+void SnapshotPublisher::place(CatalogSnapshot& next, const Course& course) {
+    const size_t chunkSize = CatalogSnapshot::CHUNK_SIZE;
+    std::shared_ptr<Course> copy;
+    if (spareCourses.empty()) {
+        copy = std::make_shared<Course>(course);
+    } else {
+        copy = std::move(spareCourses.back());
+        spareCourses.pop_back();
+        *copy = course;   // Reuses the strings' and rosters' capacity
+    }
+
+    auto it = next.index->find(course.getCode());
+    if (it != next.index->end()) {
+        size_t position = it->second;
+        auto& slot = ownChunk(next, position / chunkSize)[position % chunkSize];
+        replacedCourses.push_back(std::move(slot.course));
+        slot = {std::move(copy), next.version};
+        return;
+    }
+
+    size_t position = next.count++;
+    CatalogSnapshot::Entry added{std::move(copy), next.version};
+    if (position % chunkSize == 0) {
+        next.chunks.push_back(std::make_shared<CatalogSnapshot::Chunk>(1, std::move(added)));
+    } else {
+        ownChunk(next, next.chunks.size() - 1).push_back(std::move(added));
+    }
+    auto index = std::make_shared<CatalogSnapshot::Index>(*next.index);
+    index->emplace(course.getCode(), static_cast<uint32_t>(position));
+    next.index = std::move(index);
+}
+
+void SnapshotPublisher::publishCourses(std::initializer_list<const Course*> changed) {
+    CatalogSnapshot* next = nextVersion();
+    for (const Course* course : changed) {
+        if (course) place(*next, *course);
+    }
+    publish(next);
+}
+
+void SnapshotPublisher::publishCourses(const std::vector<const Course*>& changed) {
+    if (changed.empty()) return;
+    CatalogSnapshot* next = nextVersion();
+    for (const Course* course : changed) {
+        if (course) place(*next, *course);
+    }
+    publish(next);
+}
+
+void SnapshotPublisher::withdrawCourse(CourseCode code) {
+    const CatalogSnapshot* previous = current.load(std::memory_order_relaxed);
+    if (previous->index->count(code) == 0) return;
+
+    CatalogSnapshot* next = nextVersion();
+    auto index = std::make_shared<CatalogSnapshot::Index>(*next->index);
+    size_t position = (*index)[code];
+    size_t last = next->count - 1;
+    const size_t chunkSize = CatalogSnapshot::CHUNK_SIZE;
+
+    if (position != last) {
+        CatalogSnapshot::Entry moved = next->entry(last);   // Unchanged, so it keeps its version
+        ownChunk(*next, position / chunkSize)[position % chunkSize] = moved;
+        (*index)[moved.course->getCode()] = static_cast<uint32_t>(position);
+    }
+    index->erase(code);
+    if (last % chunkSize == 0) {
+        next->chunks.pop_back();
+    } else {
+        ownChunk(*next, last / chunkSize).pop_back();
+    }
+    next->count = last;
+    next->index = std::move(index);
+    publish(next);
+}
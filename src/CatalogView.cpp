@@ -0,0 +1,158 @@
+#include "../include/CatalogView.h"
+#include <climits>
+
+CatalogView::CatalogView() : stale(true) {}
+
+std::pair<uint32_t, uint32_t> CatalogView::intern(std::string_view text) {
+    std::pair<uint32_t, uint32_t> ref(static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(text.size()));
+    pool += text;
+    return ref;
+}
+
+std::string_view CatalogView::view(std::pair<uint32_t, uint32_t> ref) const {
+    return std::string_view(pool.data() + ref.first, ref.second);
+}
+
+void CatalogView::invalidate() {
+    stale = true;
+}
+
+bool CatalogView::isStale() const {
+    return stale;
+}
+
+void CatalogView::refresh(const CourseStore& courses) {
+    if (!stale) return;
+
+    capacity.clear();
+    enrolled.clear();
+    day.clear();
+    start.clear();
+    end.clear();
+    rowCourse.clear();
+    rowSection.clear();
+    pool.clear();
+    courseCode.clear();
+    courseTitle.clear();
+    sectionName.clear();
+    sectionRows.clear();
+
+    for (const auto& course : courses) {
+        uint32_t courseRow = static_cast<uint32_t>(courseCode.size());
+        courseCode.push_back(intern(course.getCode()));
+        courseTitle.push_back(intern(course.getTitle()));
+
+        for (const auto& section : course.getSections()) {
+            uint32_t sectionRow = static_cast<uint32_t>(sectionName.size());
+            sectionName.push_back(intern(section.getSectionID()));
+            uint32_t firstRow = static_cast<uint32_t>(capacity.size());
+
+            const auto& meetings = section.getMeetings();
+            size_t rows = meetings.empty() ? 1 : meetings.size();
+            for (size_t m = 0; m < rows; ++m) {
+                capacity.push_back(section.getCapacity());
+                enrolled.push_back(static_cast<int32_t>(section.getEnrolledStudentIDs().size()));
+                if (meetings.empty()) {
+                    day.push_back(-1);
+                    start.push_back(0);
+                    end.push_back(0);
+                } else {
+                    int meetingDay = Section::dayIndex(meetings[m].dayOfWeek);
+                    day.push_back(static_cast<int16_t>(meetingDay));
+                    start.push_back(static_cast<int16_t>(Section::timeToMinutes(meetings[m].startTime)));
+                    end.push_back(static_cast<int16_t>(Section::timeToMinutes(meetings[m].endTime)));
+                }
+                rowCourse.push_back(courseRow);
+                rowSection.push_back(sectionRow);
+            }
+            sectionRows[&section] = std::make_pair(firstRow, static_cast<uint32_t>(capacity.size()));
+        }
+    }
+    stale = false;
+}
+
+void CatalogView::onSeatsChanged(const Section& section) {
+    if (stale) return;
+    auto it = sectionRows.find(&section);
+    if (it == sectionRows.end()) {
+        stale = true;
+        return;
+    }
+    int32_t count = static_cast<int32_t>(section.getEnrolledStudentIDs().size());
+    for (uint32_t row = it->second.first; row < it->second.second; ++row) {
+        enrolled[row] = count;
+        capacity[row] = section.getCapacity();
+    }
+}
+
+size_t CatalogView::rowCount() const {
+    return capacity.size();
+}
+
+std::string_view CatalogView::getCode(size_t row) const {
+    return view(courseCode[rowCourse[row]]);
+}
+
+std::string_view CatalogView::getTitle(size_t row) const {
+    return view(courseTitle[rowCourse[row]]);
+}
+
+std::string_view CatalogView::getSectionID(size_t row) const {
+    return view(sectionName[rowSection[row]]);
+}
+
+int CatalogView::getCapacity(size_t row) const {
+    return capacity[row];
+}
+
+int CatalogView::getEnrolled(size_t row) const {
+    return enrolled[row];
+}
+
+int CatalogView::getDay(size_t row) const {
+    return day[row];
+}
+
+int CatalogView::getStart(size_t row) const {
+    return start[row];
+}
+
+int CatalogView::getEnd(size_t row) const {
+    return end[row];
+}
+
+// Two passes: a branch-free predicate over the numeric columns (which the
+// compiler vectorizes), then a branch-free compaction of matching row numbers
+std::vector<uint32_t> CatalogView::filter(const CatalogQuery& query) const {
+    const size_t n = rowCount();
+    const int16_t* dayCol = day.data();
+    const int16_t* startCol = start.data();
+    const int16_t* endCol = end.data();
+    const int32_t* capCol = capacity.data();
+    const int32_t* enrCol = enrolled.data();
+
+    // Unset bounds are widened so every row passes them
+    const int16_t wantDay = static_cast<int16_t>(query.day);
+    const uint8_t anyDay = query.day < 0 ? 1 : 0;
+    const int16_t minStart = static_cast<int16_t>(query.startsAtOrAfter < 0 ? SHRT_MIN : query.startsAtOrAfter);
+    const int16_t maxEnd = static_cast<int16_t>(query.endsAtOrBefore < 0 ? SHRT_MAX : query.endsAtOrBefore);
+    const int32_t minSeats = query.openSeatsOnly ? 1 : INT_MIN / 2;
+
+    std::vector<uint8_t> mask(n);
+    uint8_t* maskCol = mask.data();
+    for (size_t i = 0; i < n; ++i) {
+        maskCol[i] = static_cast<uint8_t>(((dayCol[i] == wantDay) | anyDay) &
+                                          (startCol[i] >= minStart) &
+                                          (endCol[i] <= maxEnd) &
+                                          (capCol[i] - enrCol[i] >= minSeats));
+    }
+
+    std::vector<uint32_t> rows(n);
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        rows[count] = static_cast<uint32_t>(i);
+        count += maskCol[i];
+    }
+    rows.resize(count);
+    return rows;
+}
@@ -0,0 +1,68 @@
+#include "../include/CohortEnrollment.h"
+#include "../include/CustomExceptions.h"
+#include <cctype>
+#include <fstream>
+
+namespace {
+
+// Numeric part of a student ID such as S12345
+long idNumber(std::string_view studentID) {
+    long value = 0;
+    for (char ch : studentID) {
+        if (std::isdigit(static_cast<unsigned char>(ch))) value = value * 10 + (ch - '0');
+    }
+    return value;
+}
+
+bool equalsIgnoreCase(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool CohortSelector::matches(const Student& student) const {
+    if (!major.empty() && !equalsIgnoreCase(student.getMajor(), major)) return false;
+    if (fromID.empty() && toID.empty()) return true;
+    long number = idNumber(student.getStudentID().view());
+    if (!fromID.empty() && number < idNumber(fromID)) return false;
+    if (!toID.empty() && number > idNumber(toID)) return false;
+    return true;
+}
+
+std::vector<std::string> CohortSelector::readIdFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw FileException(path, "read");
+    }
+    std::vector<std::string> ids;
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos || line[begin] == '#') continue;
+        size_t end = line.find_last_not_of(" \t\r");
+        ids.push_back(line.substr(begin, end - begin + 1));
+    }
+    return ids;
+}
+
+void CohortReport::print(std::ostream& out) const {
+    out << "\n--- Cohort Enrollment:";
+    for (const auto& code : courses) out << " " << code;
+    out << " ---\n";
+    out << selected << " student(s) selected, " << enrolled << " enrolled, " << failures.size() << " not enrolled\n";
+    if (!applied) {
+        out << "Not enough seats for every eligible student; nothing was changed.\n";
+    }
+    for (const auto& id : unknownIDs) {
+        out << "  " << id << ": no such student\n";
+    }
+    for (const auto& failure : failures) {
+        out << "  " << failure.studentID << ": " << failure.result.message() << "\n";
+    }
+}
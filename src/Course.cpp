@@ -4,16 +4,27 @@
 #include <sstream>
 #include <iomanip>
 
-Course::Course() : code(""), title(""), capacity(0), dayOfWeek(""), startTime(""), endTime("") {}
+Course::Course() : code(), title("") {}
 
-Course::Course(const std::string& code, const std::string& title, int capacity)
-    : code(code), title(title), capacity(capacity), dayOfWeek(""), startTime(""), endTime("") {}
+Course::Course(CourseCode code, const std::string& title)
+    : code(code), title(title) {}
 
-Course::Course(const std::string& code, const std::string& title, int capacity,
+Course::Course(CourseCode code, const std::string& title, int capacity)
+    : code(code), title(title) {
+    sections.emplace_back("001", capacity);
+}
+
+Course::Course(CourseCode code, const std::string& title, int capacity,
                const std::string& dayOfWeek, const std::string& startTime, const std::string& endTime)
-    : code(code), title(title), capacity(capacity), dayOfWeek(dayOfWeek), startTime(startTime), endTime(endTime) {}
+    : code(code), title(title) {
+    std::vector<Meeting> meetings;
+    if (!dayOfWeek.empty()) {
+        meetings.emplace_back(dayOfWeek, startTime, endTime);
+    }
+    sections.emplace_back("001", capacity, meetings);
+}
 
-const std::string& Course::getCode() const {
+CourseCode Course::getCode() const {
     return code;
 }
 
@@ -22,91 +33,139 @@ const std::string& Course::getTitle() const {
 }
 
 int Course::getCapacity() const {
-    return capacity;
+    int total = 0;
+    for (const auto& section : sections) total += section.getCapacity();
+    return total;
 }
 
 int Course::seatsRemaining() const {
-    return capacity - static_cast<int>(enrolledStudentIDs.size());
+    int total = 0;
+    for (const auto& section : sections) total += section.seatsRemaining();
+    return total;
 }
 
-const std::vector<std::string>& Course::getEnrolledStudentIDs() const {
-    return enrolledStudentIDs;
+int Course::getEnrolledCount() const {
+    int total = 0;
+    for (const auto& section : sections) total += static_cast<int>(section.getEnrolledStudentIDs().size());
+    return total;
 }
 
-bool Course::isStudentEnrolled(const std::string& studentID) const {
-    return std::find(enrolledStudentIDs.begin(), enrolledStudentIDs.end(), studentID) != enrolledStudentIDs.end();
+std::vector<StudentId> Course::getEnrolledStudentIDs() const {
+    std::vector<StudentId> all;
+    for (const auto& section : sections) {
+        const auto& ids = section.getEnrolledStudentIDs();
+        all.insert(all.end(), ids.begin(), ids.end());
+    }
+    return all;
 }
 
-void Course::enrollStudent(const std::string& studentID) {
-    if (isStudentEnrolled(studentID)) {
-        throw DuplicateEntryException("student enrollment", studentID + " in " + code);
+const std::vector<Section>& Course::getSections() const {
+    return sections;
+}
+
+Section* Course::findSection(const std::string& sectionID) {
+    if (sectionID.empty()) {
+        return sections.empty() ? nullptr : &sections.front();
     }
-    if (seatsRemaining() <= 0) {
-        throw CourseFullException(code);
+    for (auto& section : sections) {
+        if (section.getSectionID() == sectionID) return &section;
     }
-    enrolledStudentIDs.push_back(studentID);
+    return nullptr;
 }
 
-void Course::dropStudent(const std::string& studentID) {
-    auto it = std::find(enrolledStudentIDs.begin(), enrolledStudentIDs.end(), studentID);
-    if (it == enrolledStudentIDs.end()) {
-        throw RegistrationException("Student not enrolled in " + code);
+const Section* Course::findSection(const std::string& sectionID) const {
+    return const_cast<Course*>(this)->findSection(sectionID);
+}
+
+Section* Course::findSectionOf(StudentId studentID) {
+    for (auto& section : sections) {
+        if (section.isStudentEnrolled(studentID)) return &section;
     }
-    enrolledStudentIDs.erase(it);
+    return nullptr;
 }
 
-// Schedule getters
-const std::string& Course::getDayOfWeek() const {
-    return dayOfWeek;
+const Section* Course::findSectionOf(StudentId studentID) const {
+    return const_cast<Course*>(this)->findSectionOf(studentID);
 }
 
-const std::string& Course::getStartTime() const {
-    return startTime;
+void Course::addSection(const Section& section) {
+    if (!section.getSectionID().empty() && findSection(section.getSectionID()) != nullptr) {
+        throw DuplicateEntryException("section", code + " " + section.getSectionID());
+    }
+    sections.push_back(section);
 }
 
-const std::string& Course::getEndTime() const {
-    return endTime;
+void Course::removeSection(const std::string& sectionID) {
+    auto it = std::find_if(sections.begin(), sections.end(), [&](const Section& s) {
+        return s.getSectionID() == sectionID;
+    });
+    if (it == sections.end()) {
+        throw RegistrationException("Section " + sectionID + " not found in " + code);
+    }
+    sections.erase(it);
 }
 
-// Schedule setter
-void Course::setSchedule(const std::string& dayOfWeek, const std::string& startTime, const std::string& endTime) {
-    this->dayOfWeek = dayOfWeek;
-    this->startTime = startTime;
-    this->endTime = endTime;
+bool Course::isStudentEnrolled(StudentId studentID) const {
+    return findSectionOf(studentID) != nullptr;
 }
 
-// Helper method to convert time string (HH:MM) to minutes since midnight
-int Course::timeToMinutes(const std::string& time) const {
-    if (time.empty()) return 0;
-    std::istringstream iss(time);
-    int hours, minutes;
-    char colon;
-    if (iss >> hours >> colon >> minutes) {
-        return hours * 60 + minutes;
+void Course::enrollStudent(StudentId studentID, const std::string& sectionID) {
+    if (isStudentEnrolled(studentID)) {
+        throw DuplicateEntryException("student enrollment", studentID + " in " + code);
+    }
+    if (!sectionID.empty()) {
+        Section* section = findSection(sectionID);
+        if (!section) {
+            throw RegistrationException("Section " + sectionID + " not found in " + code);
+        }
+        section->enrollStudent(studentID, code);
+        return;
     }
-    return 0;
+    for (auto& section : sections) {
+        if (section.seatsRemaining() > 0) {
+            section.enrollStudent(studentID, code);
+            return;
+        }
+    }
+    throw CourseFullException(code.str());
 }
 
-// Time conflict detection
-bool Course::hasTimeConflict(const Course& other) const {
-    // If either course has no schedule, no conflict
-    if (dayOfWeek.empty() || other.dayOfWeek.empty()) {
-        return false;
+void Course::dropStudent(StudentId studentID) {
+    Section* section = findSectionOf(studentID);
+    if (!section) {
+        throw RegistrationException("Student not enrolled in " + code);
+    }
+    section->dropStudent(studentID, code);
+}
+
+// Schedule setter (replaces all meetings of the section with a single one)
+void Course::setSchedule(const std::string& dayOfWeek, const std::string& startTime, const std::string& endTime,
+                         const std::string& sectionID) {
+    setMeetings({Meeting(dayOfWeek, startTime, endTime)}, sectionID);
+}
+
+void Course::setMeetings(const std::vector<Meeting>& meetings, const std::string& sectionID) {
+    Section* section = findSection(sectionID);
+    if (!section) {
+        throw RegistrationException("Section " + sectionID + " not found in " + code);
     }
-    
-    // Courses must be on the same day to conflict
-    if (dayOfWeek != other.dayOfWeek) {
-        return false;
+    section->setMeetings(meetings);
+}
+
+void Course::clearRosters() {
+    for (auto& section : sections) {
+        section.clearRoster();
+    }
+}
+
+// Time conflict detection: the courses conflict only if no pair of sections can coexist
+bool Course::hasTimeConflict(const Course& other) const {
+    for (const auto& mine : sections) {
+        for (const auto& theirs : other.sections) {
+            if (!mine.hasTimeConflict(theirs)) return false;
+        }
     }
-    
-    // Convert times to minutes for easier comparison
-    int thisStart = timeToMinutes(startTime);
-    int thisEnd = timeToMinutes(endTime);
-    int otherStart = timeToMinutes(other.startTime);
-    int otherEnd = timeToMinutes(other.endTime);
-    
-    // Check for overlap: courses conflict if their time ranges overlap
-    return (thisStart < otherEnd && thisEnd > otherStart);
+    return !sections.empty() && !other.sections.empty();
 }
 
 // Member 3: Setters for Admin to modify courses
@@ -114,10 +173,14 @@ void Course::setCourseName(const std::string& name) {
     this->title = name;
 }
 
-void Course::setCapacity(int newCapacity) {
-    this->capacity = newCapacity;
+void Course::setCapacity(int newCapacity, const std::string& sectionID) {
+    Section* section = findSection(sectionID);
+    if (!section) {
+        throw RegistrationException("Section " + sectionID + " not found in " + code);
+    }
+    section->setCapacity(newCapacity);
 }
 
 std::string Course::getCourseName() const {
     return title;
-}
\ No newline at end of file
+}
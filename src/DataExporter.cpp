@@ -0,0 +1,324 @@
+#include "../include/DataExporter.h"
+#include "../include/CustomExceptions.h"
+#include <cstdio>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+struct SectionRow {
+    const Course& course;
+    const Section& section;
+};
+
+struct RosterRow {
+    const Course& course;
+    const Section& section;
+    StudentId studentID;
+    const Student* student;   // nullptr if the ID has no student record
+};
+
+template <typename Row>
+struct FieldSpec {
+    const char* name;
+    bool numeric;
+    void (*append)(std::string& out, const Row& row);
+};
+
+void appendInt(std::string& out, long value) {
+    char digits[24];
+    int length = std::snprintf(digits, sizeof(digits), "%ld", value);
+    out.append(digits, static_cast<size_t>(length));
+}
+
+void appendGPA(std::string& out, double gpa) {
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%.2f", gpa);
+    out.append(digits, static_cast<size_t>(length));
+}
+
+void appendMeetings(std::string& out, const Section& section) {
+    bool first = true;
+    for (const auto& meeting : section.getMeetings()) {
+        if (!first) out += ';';
+        out.append(meeting.dayOfWeek).append(" ").append(meeting.startTime).append("-").append(meeting.endTime);
+        first = false;
+    }
+}
+
+const FieldSpec<SectionRow> CATALOG_FIELDS[] = {
+    {"code", false, [](std::string& out, const SectionRow& row) { out += row.course.getCode(); }},
+    {"title", false, [](std::string& out, const SectionRow& row) { out += row.course.getTitle(); }},
+    {"section", false, [](std::string& out, const SectionRow& row) { out += row.section.getSectionID(); }},
+    {"capacity", true, [](std::string& out, const SectionRow& row) { appendInt(out, row.section.getCapacity()); }},
+    {"enrolled", true, [](std::string& out, const SectionRow& row) {
+         appendInt(out, static_cast<long>(row.section.getEnrolledStudentIDs().size()));
+     }},
+    {"seats_remaining", true, [](std::string& out, const SectionRow& row) {
+         appendInt(out, row.section.seatsRemaining());
+     }},
+    {"meetings", false, [](std::string& out, const SectionRow& row) { appendMeetings(out, row.section); }},
+};
+
+const FieldSpec<RosterRow> ROSTER_FIELDS[] = {
+    {"code", false, [](std::string& out, const RosterRow& row) { out += row.course.getCode(); }},
+    {"section", false, [](std::string& out, const RosterRow& row) { out += row.section.getSectionID(); }},
+    {"student_id", false, [](std::string& out, const RosterRow& row) { out += row.studentID; }},
+    {"name", false, [](std::string& out, const RosterRow& row) {
+         if (row.student) out += row.student->getName();
+     }},
+    {"major", false, [](std::string& out, const RosterRow& row) {
+         if (row.student) out += row.student->getMajor();
+     }},
+};
+
+const FieldSpec<Student> STUDENT_FIELDS[] = {
+    {"student_id", false, [](std::string& out, const Student& s) { out += s.getStudentID(); }},
+    {"username", false, [](std::string& out, const Student& s) { out += s.getUsername(); }},
+    {"name", false, [](std::string& out, const Student& s) { out += s.getName(); }},
+    {"email", false, [](std::string& out, const Student& s) { out += s.getEmail(); }},
+    {"major", false, [](std::string& out, const Student& s) { out += s.getMajor(); }},
+    {"gpa", true, [](std::string& out, const Student& s) { appendGPA(out, s.getGPA()); }},
+    {"enrolled_count", true, [](std::string& out, const Student& s) {
+         appendInt(out, s.getTotalEnrolledCourses());
+     }},
+    {"courses", false, [](std::string& out, const Student& s) {
+         bool first = true;
+         for (const auto& code : s.getEnrolledCourses()) {
+             if (!first) out += ';';
+             out += code;
+             first = false;
+         }
+     }},
+};
+
+template <typename Row, size_t N>
+std::vector<const FieldSpec<Row>*> selectFields(const FieldSpec<Row> (&specs)[N],
+                                                const std::vector<std::string>& names) {
+    std::vector<const FieldSpec<Row>*> selected;
+    if (names.empty()) {
+        for (const auto& spec : specs) selected.push_back(&spec);
+        return selected;
+    }
+    for (const auto& name : names) {
+        const FieldSpec<Row>* match = nullptr;
+        for (const auto& spec : specs) {
+            if (name == spec.name) match = &spec;
+        }
+        if (!match) {
+            throw InvalidInputException("export field", name, "unknown field '" + name + "'");
+        }
+        selected.push_back(match);
+    }
+    return selected;
+}
+
+// Small sink that hands the stream one BUFFER_SIZE block at a time
+class BlockWriter {
+private:
+    std::ostream& out;
+    std::string block;
+
+public:
+    explicit BlockWriter(std::ostream& out) : out(out) { block.reserve(DataExporter::BUFFER_SIZE); }
+
+    void put(char c) {
+        block += c;
+        if (block.size() >= DataExporter::BUFFER_SIZE) flush();
+    }
+    void put(const char* data, size_t length) {
+        block.append(data, length);
+        if (block.size() >= DataExporter::BUFFER_SIZE) flush();
+    }
+    void flush() {
+        out.write(block.data(), static_cast<std::streamsize>(block.size()));
+        block.clear();
+    }
+};
+
+void writeCSVCell(BlockWriter& writer, const char* data, size_t length) {
+    bool quote = false;
+    for (size_t i = 0; i < length && !quote; ++i) {
+        char c = data[i];
+        quote = c == ',' || c == '"' || c == '\n' || c == '\r';
+    }
+    if (!quote) {
+        writer.put(data, length);
+        return;
+    }
+    writer.put('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] == '"') {
+            writer.put(data + runStart, i - runStart + 1);
+            writer.put('"');
+            runStart = i + 1;
+        }
+    }
+    writer.put(data + runStart, length - runStart);
+    writer.put('"');
+}
+
+void writeJSONString(BlockWriter& writer, const char* data, size_t length) {
+    writer.put('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (c != '"' && c != '\\' && c >= 0x20) continue;
+        writer.put(data + runStart, i - runStart);
+        char escaped[8];
+        int escapedLength;
+        if (c == '"' || c == '\\') {
+            escapedLength = std::snprintf(escaped, sizeof(escaped), "\\%c", c);
+        } else if (c == '\n') {
+            escapedLength = std::snprintf(escaped, sizeof(escaped), "\\n");
+        } else {
+            escapedLength = std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        }
+        writer.put(escaped, static_cast<size_t>(escapedLength));
+        runStart = i + 1;
+    }
+    writer.put(data + runStart, length - runStart);
+    writer.put('"');
+}
+
+} // namespace
+
+std::vector<std::string> DataExporter::availableFields(ExportEntity entity) {
+    std::vector<std::string> names;
+    switch (entity) {
+        case ExportEntity::Catalog:
+            for (const auto& spec : CATALOG_FIELDS) names.push_back(spec.name);
+            break;
+        case ExportEntity::Rosters:
+            for (const auto& spec : ROSTER_FIELDS) names.push_back(spec.name);
+            break;
+        case ExportEntity::Students:
+            for (const auto& spec : STUDENT_FIELDS) names.push_back(spec.name);
+            break;
+    }
+    return names;
+}
+
+ExportSnapshot DataExporter::snapshot(const CourseStore& courses, const StudentStore& students,
+                                      const ExportOptions& options) {
+    ExportSnapshot result;
+
+    // Copies the selected cells of one row into the snapshot
+    auto capture = [&result](const auto& fields, const auto& row) {
+        for (const auto* field : fields) {
+            field->append(result.cells, row);
+            result.cellEnds.push_back(result.cells.size());
+        }
+    };
+    auto describe = [&result](const auto& fields) {
+        for (const auto* field : fields) {
+            result.fields.push_back(field->name);
+            result.numeric.push_back(field->numeric);
+        }
+    };
+
+    if (options.entity == ExportEntity::Catalog) {
+        auto fields = selectFields(CATALOG_FIELDS, options.fields);
+        describe(fields);
+        for (const auto& course : courses) {
+            if (!options.courseCode.empty() && course.getCode() != options.courseCode) continue;
+            for (const auto& section : course.getSections()) {
+                capture(fields, SectionRow{course, section});
+            }
+        }
+    } else if (options.entity == ExportEntity::Rosters) {
+        auto fields = selectFields(ROSTER_FIELDS, options.fields);
+        describe(fields);
+        // Student lookup only when a row needs more than the ID
+        bool needStudents = !options.major.empty();
+        for (const auto* field : fields) {
+            std::string name = field->name;
+            if (name == "name" || name == "major") needStudents = true;
+        }
+        std::unordered_map<StudentId, const Student*> byID;
+        if (needStudents) {
+            byID.reserve(students.size());
+            for (const auto& student : students) byID.emplace(student.getStudentID(), &student);
+        }
+        for (const auto& course : courses) {
+            if (!options.courseCode.empty() && course.getCode() != options.courseCode) continue;
+            for (const auto& section : course.getSections()) {
+                for (const auto& id : section.getEnrolledStudentIDs()) {
+                    const Student* student = nullptr;
+                    if (needStudents) {
+                        auto it = byID.find(id);
+                        if (it != byID.end()) student = it->second;
+                    }
+                    if (!options.major.empty() && (!student || student->getMajor() != options.major)) continue;
+                    capture(fields, RosterRow{course, section, id, student});
+                }
+            }
+        }
+    } else {
+        auto fields = selectFields(STUDENT_FIELDS, options.fields);
+        describe(fields);
+        // A filter that cannot be a course code matches no student
+        CourseCode filterCode;
+        bool filterValid = CourseCode::tryParse(options.courseCode, filterCode);
+        for (const auto& student : students) {
+            if (!options.major.empty() && student.getMajor() != options.major) continue;
+            if (!options.courseCode.empty() && (!filterValid || !student.isEnrolledIn(filterCode))) continue;
+            capture(fields, student);
+        }
+    }
+    return result;
+}
+
+size_t DataExporter::write(const ExportSnapshot& snapshot, ExportFormat format, std::ostream& out) {
+    BlockWriter writer(out);
+    const size_t columns = snapshot.fields.size();
+    const size_t rows = snapshot.rowCount();
+    const char* cells = snapshot.cells.data();
+
+    // JSON keys are escaped once, not once per row
+    std::vector<std::string> jsonKeys(columns);
+    if (format == ExportFormat::JSONLines) {
+        for (size_t c = 0; c < columns; ++c) {
+            std::ostringstream keyStream;
+            BlockWriter keyWriter(keyStream);
+            if (c > 0) keyWriter.put(',');
+            writeJSONString(keyWriter, snapshot.fields[c].data(), snapshot.fields[c].size());
+            keyWriter.put(':');
+            keyWriter.flush();
+            jsonKeys[c] = keyStream.str();
+        }
+    } else {
+        for (size_t c = 0; c < columns; ++c) {
+            if (c > 0) writer.put(',');
+            writeCSVCell(writer, snapshot.fields[c].data(), snapshot.fields[c].size());
+        }
+        writer.put('\n');
+    }
+
+    size_t cell = 0;
+    size_t start = 0;
+    for (size_t r = 0; r < rows; ++r) {
+        if (format == ExportFormat::JSONLines) writer.put('{');
+        for (size_t c = 0; c < columns; ++c, ++cell) {
+            size_t end = snapshot.cellEnds[cell];
+            if (format == ExportFormat::CSV) {
+                if (c > 0) writer.put(',');
+                writeCSVCell(writer, cells + start, end - start);
+            } else {
+                writer.put(jsonKeys[c].data(), jsonKeys[c].size());
+                if (snapshot.numeric[c] && end > start) {
+                    writer.put(cells + start, end - start);
+                } else {
+                    writeJSONString(writer, cells + start, end - start);
+                }
+            }
+            start = end;
+        }
+        if (format == ExportFormat::JSONLines) writer.put('}');
+        writer.put('\n');
+    }
+    writer.flush();
+    out.flush();
+    return rows;
+}
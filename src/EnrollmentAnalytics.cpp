@@ -0,0 +1,185 @@
+#include "../include/EnrollmentAnalytics.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+int gpaBucket(double gpa) {
+    if (gpa < 1.0) return 0;
+    if (gpa < 2.0) return 1;
+    if (gpa < 3.0) return 2;
+    if (gpa < 3.5) return 3;
+    return 4;
+}
+
+// Runs worker(begin, end, chunk) over 'count' items split into contiguous chunks
+template <typename Worker>
+void runChunks(size_t count, unsigned chunks, Worker worker) {
+    if (chunks <= 1) {
+        worker(0, count, 0u);
+        return;
+    }
+    std::vector<std::thread> pool;
+    size_t step = (count + chunks - 1) / chunks;
+    for (unsigned t = 0; t < chunks; ++t) {
+        size_t begin = std::min(count, t * step);
+        size_t end = std::min(count, begin + step);
+        pool.emplace_back(worker, begin, end, t);
+    }
+    for (auto& thread : pool) thread.join();
+}
+
+struct DemandGrid {
+    long cells[7][24] = {};
+};
+
+} // namespace
+
+AnalyticsReport EnrollmentAnalytics::compute(const CourseStore& courseStore, const StudentStore& studentStore,
+                                             unsigned threads) {
+    auto started = std::chrono::steady_clock::now();
+    AnalyticsReport report;
+
+    std::vector<const Course*> courses;
+    std::vector<const Student*> students;
+    courses.reserve(courseStore.size());
+    students.reserve(studentStore.size());
+    for (const auto& course : courseStore) courses.push_back(&course);
+    for (const auto& student : studentStore) students.push_back(&student);
+    report.studentCount = students.size();
+
+    unsigned workers = threads ? threads : std::thread::hardware_concurrency();
+    if (workers == 0) workers = 1;
+
+    // Student ID -> GPA, read-only once built
+    std::unordered_map<StudentId, double> gpaByID;
+    gpaByID.reserve(students.size());
+    for (const Student* student : students) {
+        gpaByID.emplace(student->getStudentID(), student->getGPA());
+    }
+
+    // ---- Per-course pass: each course writes only its own slot ----
+    report.courses.resize(courses.size());
+    std::vector<DemandGrid> demand(workers);
+    unsigned courseChunks = static_cast<unsigned>(std::min<size_t>(workers, std::max<size_t>(1, courses.size())));
+    runChunks(courses.size(), courseChunks, [&](size_t begin, size_t end, unsigned chunk) {
+        DemandGrid& grid = demand[chunk];
+        for (size_t i = begin; i < end; ++i) {
+            const Course& course = *courses[i];
+            CourseStats& stats = report.courses[i];
+            stats.code = course.getCode();
+            for (const auto& section : course.getSections()) {
+                const auto& roster = section.getEnrolledStudentIDs();
+                stats.capacity += section.getCapacity();
+                stats.enrolled += static_cast<int>(roster.size());
+                for (const auto& id : roster) {
+                    auto it = gpaByID.find(id);
+                    if (it == gpaByID.end()) continue;
+                    ++stats.gpaHistogram[gpaBucket(it->second)];
+                    stats.gpaSum += it->second;
+                    ++stats.gpaCount;
+                }
+                for (const auto& meeting : section.getMeetings()) {
+                    int day = Section::dayIndex(meeting.dayOfWeek);
+                    int hour = Section::timeToMinutes(meeting.startTime) / 60;
+                    if (day >= 0 && hour >= 0 && hour < 24) {
+                        grid.cells[day][hour] += static_cast<long>(roster.size());
+                    }
+                }
+            }
+        }
+    });
+
+    // ---- Per-student pass: per-chunk major tables, merged afterwards ----
+    unsigned studentChunks = static_cast<unsigned>(std::min<size_t>(workers, std::max<size_t>(1, students.size())));
+    std::vector<std::unordered_map<std::string, MajorStats>> partialMajors(studentChunks);
+    runChunks(students.size(), studentChunks, [&](size_t begin, size_t end, unsigned chunk) {
+        auto& table = partialMajors[chunk];
+        for (size_t i = begin; i < end; ++i) {
+            const Student& student = *students[i];
+            MajorStats& stats = table[student.getMajor()];
+            ++stats.students;
+            stats.enrollments += student.getTotalEnrolledCourses();
+            stats.gpaSum += student.getGPA();
+        }
+    });
+
+    // ---- Merge partials ----
+    std::map<std::string, MajorStats> majors;
+    for (auto& table : partialMajors) {
+        for (auto& entry : table) {
+            MajorStats& merged = majors[entry.first];
+            merged.major = entry.first;
+            merged.students += entry.second.students;
+            merged.enrollments += entry.second.enrollments;
+            merged.gpaSum += entry.second.gpaSum;
+        }
+    }
+    for (auto& entry : majors) report.majors.push_back(std::move(entry.second));
+
+    for (const auto& grid : demand) {
+        for (int d = 0; d < 7; ++d) {
+            for (int h = 0; h < 24; ++h) report.demandByDayHour[d][h] += grid.cells[d][h];
+        }
+    }
+    for (const auto& stats : report.courses) {
+        report.totalCapacity += stats.capacity;
+        report.totalEnrolled += stats.enrolled;
+    }
+
+    report.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return report;
+}
+
+void AnalyticsReport::print(std::ostream& out) const {
+    std::string text;
+    char line[256];
+
+    text += "\n========================================\n";
+    text += "        ENROLLMENT ANALYTICS            \n";
+    text += "========================================\n";
+    std::snprintf(line, sizeof(line), "Students: %zu | Courses: %zu | Seats filled: %ld / %ld (%.1f%%)\n",
+                  studentCount, courses.size(), totalEnrolled, totalCapacity,
+                  totalCapacity > 0 ? 100.0 * totalEnrolled / totalCapacity : 0.0);
+    text += line;
+
+    text += "\n--- Fill Rate and GPA by Course ---\n";
+    std::snprintf(line, sizeof(line), "%-10s %9s %7s %7s  %s\n", "Course", "Enrolled", "Fill", "AvgGPA",
+                  "GPA <1 / 1-2 / 2-3 / 3-3.5 / 3.5+");
+    text += line;
+    for (const auto& stats : courses) {
+        std::snprintf(line, sizeof(line), "%-10s %4d/%-4d %6.1f%% %7.2f  %d / %d / %d / %d / %d\n",
+                      stats.code.c_str(), stats.enrolled, stats.capacity, 100.0 * stats.fillRate(),
+                      stats.averageGPA(), stats.gpaHistogram[0], stats.gpaHistogram[1],
+                      stats.gpaHistogram[2], stats.gpaHistogram[3], stats.gpaHistogram[4]);
+        text += line;
+    }
+
+    text += "\n--- Enrollment by Major ---\n";
+    std::snprintf(line, sizeof(line), "%-16s %9s %12s %7s\n", "Major", "Students", "Enrollments", "AvgGPA");
+    text += line;
+    for (const auto& stats : majors) {
+        std::snprintf(line, sizeof(line), "%-16s %9d %12ld %7.2f\n", stats.major.c_str(), stats.students,
+                      stats.enrollments, stats.students > 0 ? stats.gpaSum / stats.students : 0.0);
+        text += line;
+    }
+
+    text += "\n--- Demand by Time of Day (enrolled seats per meeting start) ---\n";
+    for (int d = 0; d < 7; ++d) {
+        for (int h = 0; h < 24; ++h) {
+            if (demandByDayHour[d][h] == 0) continue;
+            std::snprintf(line, sizeof(line), "%-10s %02d:00  %ld\n", Section::dayName(d).c_str(), h,
+                          demandByDayHour[d][h]);
+            text += line;
+        }
+    }
+
+    std::snprintf(line, sizeof(line), "----------------------------------------\nComputed in %.1f ms\n", elapsedMs);
+    text += line;
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    out.flush();
+}
@@ -0,0 +1,264 @@
+#include "../include/EnrollmentLog.h"
+#include "../include/CustomExceptions.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+const char* enrollmentOpName(EnrollmentOp op) {
+    switch (op) {
+        case EnrollmentOp::Registered: return "Registered";
+        case EnrollmentOp::Dropped: return "Dropped";
+        case EnrollmentOp::SwappedOut: return "Swapped out";
+        case EnrollmentOp::SwappedIn: return "Swapped in";
+        case EnrollmentOp::SeatRequested: return "Seat requested";
+        case EnrollmentOp::SeatAllocated: return "Seat allocated";
+        case EnrollmentOp::SeatRevoked: return "Seat revoked";
+        case EnrollmentOp::CourseAdded: return "Course added";
+        case EnrollmentOp::CourseRemoved: return "Course removed";
+        case EnrollmentOp::TitleChanged: return "Title changed";
+        case EnrollmentOp::CapacityChanged: return "Capacity changed";
+        case EnrollmentOp::MeetingsChanged: return "Meetings changed";
+        case EnrollmentOp::SectionAdded: return "Section added";
+        case EnrollmentOp::TermRolledOver: return "Term rolled over";
+        case EnrollmentOp::SectionCancelled: return "Section cancelled";
+    }
+    return "Unknown";
+}
+
+std::string_view EnrollmentEvent::sectionID() const {
+    size_t length = 0;
+    while (length < sizeof(section) && section[length] != '\0') ++length;
+    return std::string_view(section, length);
+}
+
+void EnrollmentEvent::setSection(std::string_view sectionID) {
+    std::fill(std::begin(section), std::end(section), '\0');
+    std::copy_n(sectionID.begin(), std::min(sectionID.size(), sizeof(section)), section);
+}
+
+bool EnrollmentEvent::grantsSeat() const {
+    return op == EnrollmentOp::Registered || op == EnrollmentOp::SwappedIn || op == EnrollmentOp::SeatAllocated;
+}
+
+bool EnrollmentEvent::releasesSeat() const {
+    return op == EnrollmentOp::Dropped || op == EnrollmentOp::SwappedOut || op == EnrollmentOp::SeatRevoked;
+}
+
+EnrollmentLog::EnrollmentLog(std::string directory)
+    : directory(std::move(directory)), indexed(false), lastTime(INT64_MIN), openSegment(0) {}
+
+EnrollmentLog::~EnrollmentLog() {
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // Nothing to report to from a destructor
+    }
+}
+
+std::string EnrollmentLog::segmentPath(uint32_t number) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "segment-%06u.bin", number);
+    return (std::filesystem::path(directory) / name).string();
+}
+
+void EnrollmentLog::buildIndex() const {
+    indexed = true;
+    segments.clear();
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) return;
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        unsigned number = 0;
+        char tail = '\0';
+        std::string name = entry.path().filename().string();
+        if (std::sscanf(name.c_str(), "segment-%u.bi%c", &number, &tail) != 2 || tail != 'n') continue;
+
+        // A record cut short by a crash is dropped so appends stay aligned
+        uintmax_t bytes = entry.file_size();
+        size_t count = static_cast<size_t>(bytes / sizeof(EnrollmentEvent));
+        if (bytes % sizeof(EnrollmentEvent) != 0) {
+            std::filesystem::resize_file(entry.path(), count * sizeof(EnrollmentEvent));
+        }
+        if (count == 0) continue;
+
+        std::ifstream file(entry.path(), std::ios::binary);
+        EnrollmentEvent first, last;
+        file.read(reinterpret_cast<char*>(&first), sizeof(first));
+        file.seekg(static_cast<std::streamoff>((count - 1) * sizeof(EnrollmentEvent)));
+        file.read(reinterpret_cast<char*>(&last), sizeof(last));
+        if (!file) {
+            throw FileException(entry.path().string(), "read");
+        }
+        segments.push_back(Segment{number, first.time, last.time, count});
+    }
+    std::sort(segments.begin(), segments.end(),
+              [](const Segment& a, const Segment& b) { return a.number < b.number; });
+}
+
+int64_t EnrollmentLog::now() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+void EnrollmentLog::append(EnrollmentEvent event) {
+    if (!indexed) buildIndex();
+    if (lastTime == INT64_MIN && !segments.empty()) lastTime = segments.back().last;
+
+    event.time = std::max(now(), lastTime);
+    lastTime = event.time;
+
+    if (segments.empty() || segments.back().count + pending.size() >= SEGMENT_EVENTS) {
+        flush();
+        uint32_t number = segments.empty() ? 1 : segments.back().number + 1;
+        segments.push_back(Segment{number, event.time, event.time, 0});
+    }
+    segments.back().last = event.time;
+    pending.push_back(event);
+    if (pending.size() >= FLUSH_EVENTS) flush();
+}
+
+void EnrollmentLog::flush() {
+    if (pending.empty()) return;
+    uint32_t number = segments.back().number;
+    if (!segmentFile.is_open() || openSegment != number) {
+        segmentFile.close();
+        segmentFile.clear();
+        std::filesystem::create_directories(directory);
+        segmentFile.open(segmentPath(number), std::ios::binary | std::ios::app);
+        openSegment = number;
+    }
+    segmentFile.write(reinterpret_cast<const char*>(pending.data()),
+                      static_cast<std::streamsize>(pending.size() * sizeof(EnrollmentEvent)));
+    segmentFile.flush();   // Queries read the segment through their own stream
+    if (!segmentFile) {
+        segmentFile.close();
+        throw FileException(segmentPath(number), "write");
+    }
+    segments.back().count += pending.size();
+    pending.clear();
+}
+
+void EnrollmentLog::readSegment(const Segment& segment, int64_t from, int64_t to,
+                                std::vector<EnrollmentEvent>& out) const {
+    if (segment.count > 0) {
+        std::string path = segmentPath(segment.number);
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw FileException(path, "read");
+        }
+        auto timeAt = [&file](size_t position) {
+            int64_t time = 0;
+            file.seekg(static_cast<std::streamoff>(position * sizeof(EnrollmentEvent)));
+            file.read(reinterpret_cast<char*>(&time), sizeof(time));
+            return time;
+        };
+        // First record at or after from, first record after to
+        size_t begin = 0, end = segment.count;
+        if (from > segment.first) {
+            size_t low = 0, high = segment.count;
+            while (low < high) {
+                size_t mid = low + (high - low) / 2;
+                if (timeAt(mid) < from) low = mid + 1;
+                else high = mid;
+            }
+            begin = low;
+        }
+        if (to < segment.last) {
+            size_t low = begin, high = segment.count;
+            while (low < high) {
+                size_t mid = low + (high - low) / 2;
+                if (timeAt(mid) <= to) low = mid + 1;
+                else high = mid;
+            }
+            end = low;
+        }
+        if (begin < end) {
+            size_t offset = out.size();
+            out.resize(offset + (end - begin));
+            file.seekg(static_cast<std::streamoff>(begin * sizeof(EnrollmentEvent)));
+            file.read(reinterpret_cast<char*>(out.data() + offset),
+                      static_cast<std::streamsize>((end - begin) * sizeof(EnrollmentEvent)));
+            if (!file) {
+                throw FileException(path, "read");
+            }
+        }
+    }
+    if (&segment == &segments.back()) {
+        for (const auto& event : pending) {
+            if (event.time >= from && event.time <= to) out.push_back(event);
+        }
+    }
+}
+
+void EnrollmentLog::scan(int64_t from, int64_t to, const std::function<void(const EnrollmentEvent&)>& visit) const {
+    if (!indexed) buildIndex();
+    std::vector<EnrollmentEvent> batch;
+    for (const auto& segment : segments) {
+        if (segment.last < from || segment.first > to) continue;
+        batch.clear();
+        readSegment(segment, from, to, batch);
+        for (const auto& event : batch) visit(event);
+    }
+}
+
+std::vector<EnrollmentEvent> EnrollmentLog::find(const EventQuery& query) const {
+    std::vector<EnrollmentEvent> matches;
+    scan(query.from, query.to, [&](const EnrollmentEvent& event) {
+        if (!query.student.empty() && event.student != query.student) return;
+        if (!query.course.empty() && event.course != query.course) return;
+        matches.push_back(event);
+    });
+    return matches;
+}
+
+size_t EnrollmentLog::segmentCount() const {
+    if (!indexed) buildIndex();
+    return segments.size();
+}
+
+size_t EnrollmentLog::eventCount() const {
+    if (!indexed) buildIndex();
+    size_t total = pending.size();
+    for (const auto& segment : segments) total += segment.count;
+    return total;
+}
+
+bool EnrollmentLog::parseTime(const std::string& text, int64_t& time) {
+    std::tm fields = {};
+    std::istringstream in(text);
+    in >> std::get_time(&fields, "%Y-%m-%d %H:%M:%S");
+    if (in.fail()) return false;
+    in >> std::ws;
+    if (!in.eof()) return false;
+    fields.tm_isdst = -1;
+    std::time_t seconds = std::mktime(&fields);
+    if (seconds == -1) return false;
+    time = static_cast<int64_t>(seconds) * 1000000;
+    return true;
+}
+
+std::string EnrollmentLog::formatTime(int64_t time) {
+    int64_t micros = time % 1000000;
+    if (micros < 0) micros += 1000000;
+    std::time_t seconds = static_cast<std::time_t>((time - micros) / 1000000);
+    std::tm fields = *std::localtime(&seconds);
+    std::ostringstream out;
+    out << std::put_time(&fields, "%Y-%m-%d %H:%M:%S") << '.' << std::setfill('0') << std::setw(3) << micros / 1000;
+    return out.str();
+}
+
+void EnrollmentLog::print(std::ostream& out, const EnrollmentEvent& event) {
+    std::ios::fmtflags flags = out.flags();
+    out << formatTime(event.time) << "  " << std::left << std::setw(18) << enrollmentOpName(event.op)
+        << std::setw(8) << (event.student.empty() ? "-" : event.student.str()) << "  ";
+    std::string course = event.course.empty() ? "-" : event.course.str();
+    if (!event.sectionID().empty()) course += ":" + std::string(event.sectionID());
+    out << std::setw(13) << course << "by " << (event.actor.empty() ? "system" : event.actor.str()) << "\n";
+    out.flags(flags);
+}
@@ -1,4 +1,6 @@
 #include "../include/InputValidator.h"
+#include "../include/Section.h"
+#include "../include/Keys.h"
 #include <algorithm>
 #include <cctype>
 
@@ -13,10 +15,7 @@ bool InputValidator::isValidEmail(const string& email) {
 
 // Student ID validation (S followed by 4-6 digits)
 bool InputValidator::isValidStudentID(const string& studentID) {
-    if (studentID.empty() || studentID[0] != 'S') return false;
-    
-    regex idPattern(R"(S\d{4,6})");
-    return regex_match(studentID, idPattern);
+    return StudentId::isValidFormat(studentID);
 }
 
 // User ID validation (U followed by digits)
@@ -29,10 +28,7 @@ bool InputValidator::isValidUserID(const string& userID) {
 
 // Course code validation (2-4 letters followed by 3 digits)
 bool InputValidator::isValidCourseCode(const string& courseCode) {
-    if (courseCode.empty()) return false;
-    
-    regex codePattern(R"([A-Z]{2,4}\d{3})");
-    return regex_match(courseCode, codePattern);
+    return CourseCode::isValidFormat(courseCode);
 }
 
 // GPA validation (0.0 to 4.0)
@@ -59,6 +55,49 @@ bool InputValidator::isValidDayOfWeek(const string& day) {
     return false;
 }
 
+// Section ID validation (1-4 letters or digits)
+bool InputValidator::isValidSectionID(const string& sectionID) {
+    regex sectionPattern(R"([A-Z0-9]{1,4})");
+    return regex_match(sectionID, sectionPattern);
+}
+
+// Term ID validation (e.g. 2026-FALL, SPRING27)
+bool InputValidator::isValidTermID(const string& termID) {
+    regex termPattern(R"([A-Za-z0-9-]{1,12})");
+    return regex_match(termID, termPattern);
+}
+
+// Single meeting validation (start must be before end on the same day)
+bool InputValidator::isValidMeeting(const string& day, const string& startTime, const string& endTime) {
+    if (!isValidDayOfWeek(day) || !isValidTimeFormat(startTime) || !isValidTimeFormat(endTime)) {
+        return false;
+    }
+    return Section::timeToMinutes(startTime) < Section::timeToMinutes(endTime);
+}
+
+// Meeting list validation - every entry valid and no two meetings overlap
+bool InputValidator::isValidMeetingList(const string& spec) {
+    vector<Meeting> meetings;
+    try {
+        meetings = Section::parseMeetings(spec);
+    } catch (...) {
+        return false;
+    }
+    if (meetings.empty()) return false;
+    
+    for (const auto& meeting : meetings) {
+        if (!isValidMeeting(meeting.dayOfWeek, meeting.startTime, meeting.endTime)) return false;
+    }
+    
+    sort(meetings.begin(), meetings.end(), [](const Meeting& a, const Meeting& b) {
+        return a.weekStart < b.weekStart;
+    });
+    for (size_t i = 1; i < meetings.size(); i++) {
+        if (meetings[i - 1].overlaps(meetings[i])) return false;
+    }
+    return true;
+}
+
 // Password validation (minimum 6 characters)
 bool InputValidator::isValidPassword(const string& password) {
     return password.length() >= 6;
@@ -104,6 +143,20 @@ bool InputValidator::isValidPositiveInteger(const string& input) {
     }
 }
 
+// Read a menu line as an integer
+int InputValidator::parseInteger(const string& input, int fallback) {
+    size_t first = input.find_first_not_of(' ');
+    if (first == string::npos) return fallback;
+    string trimmed = input.substr(first, input.find_last_not_of(' ') - first + 1);
+    if (!isValidInteger(trimmed)) return fallback;
+    
+    try {
+        return stoi(trimmed);
+    } catch (...) {
+        return fallback;
+    }
+}
+
 // Validate capacity (1 to 500 seems reasonable)
 bool InputValidator::isValidCapacity(int capacity) {
     return capacity > 0 && capacity <= 500;
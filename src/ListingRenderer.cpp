@@ -0,0 +1,221 @@
+#include "../include/ListingRenderer.h"
+#include <cstdio>
+
+void ListingRenderer::writePage(std::ostream& out) {
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    buffer.clear();  // Keeps capacity for the next page
+}
+
+void ListingRenderer::appendCourse(const Course& course, CatalogStyle style, std::string& into) {
+    into += "Code: " + course.getCode() + "\n";
+    into += "Title: " + course.getTitle() + "\n";
+    if (style == CatalogStyle::Student) {
+        into += "Capacity: " + std::to_string(course.getCapacity()) +
+                " | Seats Remaining: " + std::to_string(course.seatsRemaining()) + "\n";
+        for (const auto& section : course.getSections()) {
+            into += "  Section " + section.getSectionID() + " (" + std::to_string(section.seatsRemaining()) +
+                    "/" + std::to_string(section.getCapacity()) + " open)";
+            if (!section.getMeetings().empty()) {
+                into += ": " + section.scheduleString();
+            }
+            into += "\n";
+        }
+        into += "-------------------------------------\n";
+    } else {
+        into += "Capacity: " + std::to_string(course.getCapacity()) +
+                " | Enrolled: " + std::to_string(course.getEnrolledCount()) +
+                " | Remaining: " + std::to_string(course.seatsRemaining()) + "\n";
+        for (const auto& section : course.getSections()) {
+            into += "  Section " + section.getSectionID() +
+                    " | Capacity: " + std::to_string(section.getCapacity()) +
+                    " | Enrolled: " + std::to_string(section.getEnrolledStudentIDs().size());
+            if (!section.getMeetings().empty()) {
+                into += " | Schedule: " + section.scheduleString();
+            }
+            into += "\n";
+        }
+        into += "----------------------------------------\n";
+    }
+}
+
+const std::string& ListingRenderer::courseBlock(const CatalogSnapshot& catalog, size_t position,
+                                                CatalogStyle style) {
+    auto& cache = style == CatalogStyle::Student ? studentBlocks : adminBlocks;
+    const Course& course = catalog.at(position);
+    CachedBlock& block = cache[course.getCode()];
+    uint64_t changedIn = catalog.changedIn(position);
+    if (block.changedIn != changedIn) {   // Versions start at 1, so a new entry always renders
+        block.text.clear();
+        appendCourse(course, style, block.text);
+        block.changedIn = changedIn;
+    }
+    return block.text;
+}
+
+void ListingRenderer::beginCatalog(ListingCursor& cursor, CatalogStyle style, bool empty) {
+    if (cursor.started) return;
+    cursor.started = true;
+    if (style == CatalogStyle::Student) {
+        buffer += "\n=====================================\n";
+        buffer += "      AVAILABLE COURSES              \n";
+        buffer += "=====================================\n";
+    } else if (empty) {
+        buffer += "\nNo courses available in the system.\n";
+    } else {
+        buffer += "\n========================================\n";
+        buffer += "          ALL COURSES IN SYSTEM        \n";
+        buffer += "========================================\n";
+    }
+}
+
+void ListingRenderer::endCatalogPage(const ListingCursor& cursor, CatalogStyle style, size_t total,
+                                     std::ostream& out) {
+    if (cursor.done) {
+        if (style == CatalogStyle::Student) {
+            buffer += "\n";
+        } else if (total != 0) {
+            buffer += "Total Courses: " + std::to_string(total) + "\n";
+        }
+    } else {
+        buffer += "Showing " + std::to_string(cursor.shown) + " of " + std::to_string(total) + " courses\n";
+    }
+    writePage(out);
+}
+
+void ListingRenderer::renderCatalogPage(const CatalogSnapshot& catalog, CatalogStyle style, ListingCursor& cursor,
+                                        size_t pageSize, std::ostream& out) {
+    beginCatalog(cursor, style, catalog.empty());
+    size_t position = cursor.slot;
+    for (; position < catalog.size() && (pageSize == 0 || position - cursor.slot < pageSize); ++position) {
+        buffer += courseBlock(catalog, position, style);
+    }
+    cursor.shown += position - cursor.slot;
+    cursor.slot = static_cast<uint32_t>(position);
+    cursor.done = position >= catalog.size();
+    endCatalogPage(cursor, style, catalog.size(), out);
+}
+
+void ListingRenderer::renderCatalogPage(const CourseStore& courses, CatalogStyle style, ListingCursor& cursor,
+                                        size_t pageSize, std::ostream& out) {
+    beginCatalog(cursor, style, courses.empty());
+    size_t rendered = 0;
+    auto it = courses.from(cursor.slot);
+    for (; it != courses.end() && (pageSize == 0 || rendered < pageSize); ++it, ++rendered) {
+        appendCourse(*it, style, buffer);
+    }
+    cursor.shown += rendered;
+    cursor.slot = it.slotIndex();
+    cursor.done = it == courses.end();
+    endCatalogPage(cursor, style, courses.size(), out);
+}
+
+void ListingRenderer::renderRosterPage(const Course& course, ListingCursor& cursor, size_t pageSize,
+                                       std::ostream& out) {
+    const auto& sections = course.getSections();
+    if (!cursor.started) {
+        cursor.started = true;
+        buffer += "\n=== Enrollments for Course: " + course.getCode() + " ===\n";
+        buffer += "Course Title: " + course.getTitle() + "\n";
+        buffer += "Enrolled Students: " + std::to_string(course.getEnrolledCount()) +
+                  " / " + std::to_string(course.getCapacity()) + "\n";
+        buffer += "----------------------------------------\n";
+        if (course.getEnrolledCount() == 0) {
+            buffer += "No students enrolled yet.\n";
+            cursor.done = true;
+            writePage(out);
+            return;
+        }
+    }
+
+    size_t rendered = 0;
+    while (cursor.section < sections.size() && (pageSize == 0 || rendered < pageSize)) {
+        const Section& section = sections[cursor.section];
+        const auto& enrolledIDs = section.getEnrolledStudentIDs();
+        if (cursor.item == 0) {
+            buffer += "Section " + section.getSectionID() + " (" + std::to_string(enrolledIDs.size()) +
+                      " / " + std::to_string(section.getCapacity()) + ")\n";
+        }
+        while (cursor.item < enrolledIDs.size() && (pageSize == 0 || rendered < pageSize)) {
+            buffer.append(std::to_string(cursor.item + 1)).append(". Student ID: ")
+                  .append(enrolledIDs[cursor.item]).append("\n");
+            ++cursor.item;
+            ++rendered;
+        }
+        if (cursor.item >= enrolledIDs.size()) {
+            ++cursor.section;
+            cursor.item = 0;
+        }
+    }
+    cursor.shown += rendered;
+
+    if (cursor.section >= sections.size()) {
+        cursor.done = true;
+    } else {
+        buffer += "Showing " + std::to_string(cursor.shown) + " of " +
+                  std::to_string(course.getEnrolledCount()) + " students\n";
+    }
+    writePage(out);
+}
+
+bool ListingRenderer::beginStudents(ListingCursor& cursor, size_t total, std::ostream& out) {
+    if (cursor.started) return true;
+    cursor.started = true;
+    if (total == 0) {
+        buffer += "\nNo students in the system.\n";
+        cursor.done = true;
+        writePage(out);
+        return false;
+    }
+    buffer += "\n========================================\n";
+    buffer += "          ALL STUDENTS IN SYSTEM       \n";
+    buffer += "========================================\n";
+    return true;
+}
+
+void ListingRenderer::appendStudent(const Student& student) {
+    char gpa[32];
+    std::snprintf(gpa, sizeof(gpa), "%.2f", student.getGPA());
+    // Appended piecewise to avoid building temporary strings per line
+    buffer.append("Name: ").append(student.getName())
+          .append("\nUsername: ").append(student.getUsername())
+          .append("\nStudent ID: ").append(student.getStudentID())
+          .append("\nMajor: ").append(student.getMajor())
+          .append("\nGPA: ").append(gpa)
+          .append("\nEnrolled Courses: ").append(std::to_string(student.getTotalEnrolledCourses()))
+          .append("\n----------------------------------------\n");
+}
+
+void ListingRenderer::endStudentsPage(const ListingCursor& cursor, size_t total, std::ostream& out) {
+    if (cursor.done) {
+        buffer += "Total Students: " + std::to_string(total) + "\n";
+    } else {
+        buffer += "Showing " + std::to_string(cursor.shown) + " of " + std::to_string(total) + " students\n";
+    }
+    writePage(out);
+}
+
+void ListingRenderer::renderStudentsPage(const StudentStore& students, ListingCursor& cursor, size_t pageSize,
+                                         std::ostream& out) {
+    if (!beginStudents(cursor, students.size(), out)) return;
+
+    size_t rendered = 0;
+    auto it = students.from(cursor.slot);
+    for (; it != students.end() && (pageSize == 0 || rendered < pageSize); ++it, ++rendered) {
+        appendStudent(*it);
+    }
+    cursor.shown += rendered;
+    cursor.slot = it.slotIndex();
+    cursor.done = it == students.end();
+    endStudentsPage(cursor, students.size(), out);
+}
+
+void ListingRenderer::renderStudentsPage(const std::vector<const Student*>& page, size_t total, bool last,
+                                         ListingCursor& cursor, std::ostream& out) {
+    if (!beginStudents(cursor, total, out)) return;
+
+    for (const Student* student : page) appendStudent(*student);
+    cursor.shown += page.size();
+    cursor.done = last;
+    endStudentsPage(cursor, total, out);
+}
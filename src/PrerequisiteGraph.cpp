@@ -0,0 +1,294 @@
+#include "../include/PrerequisiteGraph.h"
+#include "../include/CustomExceptions.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+bool contains(const std::vector<uint32_t>& list, uint32_t node) {
+    return std::find(list.begin(), list.end(), node) != list.end();
+}
+
+bool erase(std::vector<uint32_t>& list, uint32_t node) {
+    auto it = std::find(list.begin(), list.end(), node);
+    if (it == list.end()) return false;
+    list.erase(it);
+    return true;
+}
+
+} // namespace
+
+uint32_t PrerequisiteGraph::nodeOf(CourseCode code) {
+    auto it = nodeIndex.find(code);
+    if (it != nodeIndex.end()) return it->second;
+    uint32_t node = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    nodes.back().code = code;
+    nodeIndex.emplace(code, node);
+    return node;
+}
+
+const PrerequisiteGraph::Node* PrerequisiteGraph::find(CourseCode code) const {
+    auto it = nodeIndex.find(code);
+    return it == nodeIndex.end() ? nullptr : &nodes[it->second];
+}
+
+bool PrerequisiteGraph::dependsOn(uint32_t node, uint32_t other) const {
+    const auto& closure = nodes[node].closure;
+    size_t word = other / 64;
+    return word < closure.size() && (closure[word] >> (other % 64) & 1) != 0;
+}
+
+void PrerequisiteGraph::rebuildClosure(uint32_t node) {
+    Node& target = nodes[node];
+    target.closure.clear();
+    for (uint32_t p : target.prerequisites) {
+        const Node& prerequisite = nodes[p];
+        size_t needed = std::max<size_t>(p / 64 + 1, prerequisite.closure.size());
+        if (target.closure.size() < needed) target.closure.resize(needed, 0);
+        target.closure[p / 64] |= uint64_t(1) << (p % 64);
+        for (uint32_t w : prerequisite.closureWords) target.closure[w] |= prerequisite.closure[w];
+    }
+    target.closureWords.clear();
+    for (size_t w = 0; w < target.closure.size(); ++w) {
+        if (target.closure[w] != 0) target.closureWords.push_back(static_cast<uint32_t>(w));
+    }
+}
+
+void PrerequisiteGraph::recomputeFrom(uint32_t node) {
+    // Affected: node and its transitive dependents. Each count is the number
+    // of affected direct prerequisites still waiting to be rebuilt.
+    std::unordered_map<uint32_t, int> waiting;
+    std::vector<uint32_t> stack{node};
+    waiting[node] = 0;
+    while (!stack.empty()) {
+        uint32_t current = stack.back();
+        stack.pop_back();
+        for (uint32_t d : nodes[current].dependents) {
+            if (waiting.emplace(d, 0).second) stack.push_back(d);
+        }
+    }
+    for (auto& entry : waiting) {
+        for (uint32_t p : nodes[entry.first].prerequisites) {
+            if (waiting.count(p) != 0) ++entry.second;
+        }
+    }
+
+    // Rebuild in dependency order (the graph is acyclic)
+    std::vector<uint32_t> ready;
+    for (const auto& entry : waiting) {
+        if (entry.second == 0) ready.push_back(entry.first);
+    }
+    while (!ready.empty()) {
+        uint32_t current = ready.back();
+        ready.pop_back();
+        rebuildClosure(current);
+        for (uint32_t d : nodes[current].dependents) {
+            if (--waiting[d] == 0) ready.push_back(d);
+        }
+    }
+}
+
+void PrerequisiteGraph::addPrerequisite(CourseCode course, CourseCode required) {
+    if (course == required) {
+        throw InvalidInputException("prerequisite", required.str(), "a course cannot require itself");
+    }
+    uint32_t c = nodeOf(course);
+    uint32_t r = nodeOf(required);
+    if (contains(nodes[c].prerequisites, r)) {
+        throw DuplicateEntryException("prerequisite", course + " requires " + required);
+    }
+    if (dependsOn(r, c)) {
+        throw RegistrationException("Cannot make " + course + " require " + required + ": " + required +
+                                    " already requires " + course + " (directly or indirectly)");
+    }
+    if (contains(nodes[r].corequisites, c)) {
+        throw RegistrationException("Cannot make " + course + " require " + required + ": " + required +
+                                    " lists " + course + " as a corequisite");
+    }
+    nodes[c].prerequisites.push_back(r);
+    nodes[r].dependents.push_back(c);
+    recomputeFrom(c);
+}
+
+void PrerequisiteGraph::addCorequisite(CourseCode course, CourseCode other) {
+    if (course == other) {
+        throw InvalidInputException("corequisite", other.str(), "a course cannot be its own corequisite");
+    }
+    uint32_t c = nodeOf(course);
+    uint32_t o = nodeOf(other);
+    if (contains(nodes[c].corequisites, o)) {
+        throw DuplicateEntryException("corequisite", course + " with " + other);
+    }
+    if (dependsOn(o, c)) {
+        throw RegistrationException("Cannot make " + other + " a corequisite of " + course + ": " + other +
+                                    " requires " + course + " to be completed first");
+    }
+    nodes[c].corequisites.push_back(o);
+}
+
+bool PrerequisiteGraph::removePrerequisite(CourseCode course, CourseCode required) {
+    auto c = nodeIndex.find(course);
+    auto r = nodeIndex.find(required);
+    if (c == nodeIndex.end() || r == nodeIndex.end()) return false;
+    if (!erase(nodes[c->second].prerequisites, r->second)) return false;
+    erase(nodes[r->second].dependents, c->second);
+    recomputeFrom(c->second);
+    return true;
+}
+
+bool PrerequisiteGraph::removeCorequisite(CourseCode course, CourseCode other) {
+    auto c = nodeIndex.find(course);
+    auto o = nodeIndex.find(other);
+    if (c == nodeIndex.end() || o == nodeIndex.end()) return false;
+    return erase(nodes[c->second].corequisites, o->second);
+}
+
+void PrerequisiteGraph::removeCourse(CourseCode code) {
+    auto it = nodeIndex.find(code);
+    if (it == nodeIndex.end()) return;
+    uint32_t node = it->second;
+
+    for (uint32_t p : nodes[node].prerequisites) erase(nodes[p].dependents, node);
+    nodes[node].prerequisites.clear();
+    nodes[node].corequisites.clear();
+    std::vector<uint32_t> dependents;
+    dependents.swap(nodes[node].dependents);
+    for (uint32_t d : dependents) erase(nodes[d].prerequisites, node);
+    for (auto& other : nodes) erase(other.corequisites, node);
+
+    rebuildClosure(node);
+    for (uint32_t d : dependents) recomputeFrom(d);
+}
+
+void PrerequisiteGraph::clear() {
+    nodes.clear();
+    nodeIndex.clear();
+    scratch.clear();
+}
+
+std::vector<CourseCode> PrerequisiteGraph::prerequisitesOf(CourseCode course) const {
+    std::vector<CourseCode> codes;
+    if (const Node* node = find(course)) {
+        for (uint32_t p : node->prerequisites) codes.push_back(nodes[p].code);
+    }
+    return codes;
+}
+
+std::vector<CourseCode> PrerequisiteGraph::corequisitesOf(CourseCode course) const {
+    std::vector<CourseCode> codes;
+    if (const Node* node = find(course)) {
+        for (uint32_t o : node->corequisites) codes.push_back(nodes[o].code);
+    }
+    return codes;
+}
+
+std::vector<CourseCode> PrerequisiteGraph::allPrerequisitesOf(CourseCode course) const {
+    std::vector<CourseCode> codes;
+    if (const Node* node = find(course)) {
+        for (uint32_t w : node->closureWords) {
+            for (uint64_t bits = node->closure[w]; bits != 0; bits &= bits - 1) {
+                codes.push_back(nodes[w * 64 + std::countr_zero(bits)].code);
+            }
+        }
+    }
+    return codes;
+}
+
+bool PrerequisiteGraph::findMissing(CourseCode course, const std::vector<CourseCode>& completed,
+                                    const std::vector<CourseCode>& enrolled, CourseCode& missing,
+                                    bool& corequisite) {
+    const Node* node = find(course);
+    if (!node) return false;
+
+    // Mark the completed courses, test, then clear only the bits that were set
+    if (scratch.size() < (nodes.size() + 63) / 64) scratch.resize((nodes.size() + 63) / 64, 0);
+    for (const auto& code : completed) {
+        auto it = nodeIndex.find(code);
+        if (it != nodeIndex.end()) scratch[it->second / 64] |= uint64_t(1) << (it->second % 64);
+    }
+
+    bool found = false;
+    for (uint32_t w : node->closureWords) {
+        uint64_t gap = node->closure[w] & ~scratch[w];
+        if (gap != 0) {
+            missing = nodes[w * 64 + std::countr_zero(gap)].code;
+            corequisite = false;
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        for (uint32_t o : node->corequisites) {
+            bool done = (scratch[o / 64] >> (o % 64) & 1) != 0;
+            if (!done && std::find(enrolled.begin(), enrolled.end(), nodes[o].code) == enrolled.end()) {
+                missing = nodes[o].code;
+                corequisite = true;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    for (const auto& code : completed) {
+        auto it = nodeIndex.find(code);
+        if (it != nodeIndex.end()) scratch[it->second / 64] &= ~(uint64_t(1) << (it->second % 64));
+    }
+    return found;
+}
+
+void PrerequisiteGraph::load(const std::string& path) {
+    clear();
+    std::ifstream file(path);
+    if (!file.is_open()) return;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        std::string codeStr, prerequisiteList, corequisiteList;
+        std::getline(ss, codeStr, '|');
+        std::getline(ss, prerequisiteList, '|');
+        std::getline(ss, corequisiteList, '|');
+        CourseCode course;
+        if (!CourseCode::tryParse(codeStr, course)) continue;
+
+        for (int pass = 0; pass < 2; ++pass) {
+            std::stringstream items(pass == 0 ? prerequisiteList : corequisiteList);
+            std::string item;
+            while (std::getline(items, item, ',')) {
+                CourseCode other;
+                if (!CourseCode::tryParse(item, other)) continue;
+                try {
+                    if (pass == 0) addPrerequisite(course, other);
+                    else addCorequisite(course, other);
+                } catch (const RegistrationException&) {
+                    // skip duplicates and relations that would form a cycle
+                }
+            }
+        }
+    }
+}
+
+void PrerequisiteGraph::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        throw FileException(path, "write");
+    }
+    for (const auto& node : nodes) {
+        if (node.prerequisites.empty() && node.corequisites.empty()) continue;
+        file << node.code << '|';
+        for (size_t i = 0; i < node.prerequisites.size(); ++i) {
+            if (i > 0) file << ',';
+            file << nodes[node.prerequisites[i]].code;
+        }
+        file << '|';
+        for (size_t i = 0; i < node.corequisites.size(); ++i) {
+            if (i > 0) file << ',';
+            file << nodes[node.corequisites[i]].code;
+        }
+        file << '\n';
+    }
+}
@@ -0,0 +1,95 @@
+#include "../include/RegistrationResult.h"
+#include "../include/CustomExceptions.h"
+
+void RegistrationResult::raise() const {
+    switch (status) {
+        case RegistrationStatus::Ok:
+            return;
+        case RegistrationStatus::CourseNotFound:
+            throw RegistrationException("Course " + courseCode + " not found");
+        case RegistrationStatus::SectionNotFound:
+            throw RegistrationException("Section " + sectionID + " not found in " + courseCode);
+        case RegistrationStatus::AlreadyEnrolled:
+            throw DuplicateEntryException("student enrollment", studentID + " in " + courseCode);
+        case RegistrationStatus::NotEnrolled:
+            throw RegistrationException("Student not enrolled in " + courseCode);
+        case RegistrationStatus::CourseFull:
+            throw CourseFullException(sectionID.empty() ? courseCode : courseCode + " section " + sectionID);
+        case RegistrationStatus::TimeConflict:
+            throw TimeConflictException(courseCode, conflictingCourse.str(), conflictDay);
+        case RegistrationStatus::MissingPrerequisite:
+        case RegistrationStatus::MissingCorequisite:
+            throw PrerequisiteException(courseCode, missingCourse.str(),
+                                        status == RegistrationStatus::MissingCorequisite);
+        case RegistrationStatus::RuleViolation:
+            throw RuleViolationException(courseCode, ruleName, ruleText);
+        case RegistrationStatus::TryLater:
+            throw TryLaterException(courseCode, retryAfterMs);
+    }
+}
+
+std::string RegistrationResult::message() const {
+    std::string seat = sectionID.empty() ? courseCode : courseCode + " section " + sectionID;
+    switch (status) {
+        case RegistrationStatus::Ok:
+            return "OK";
+        case RegistrationStatus::CourseNotFound:
+            return "Course " + courseCode + " not found";
+        case RegistrationStatus::SectionNotFound:
+            return "Section " + sectionID + " not found in " + courseCode;
+        case RegistrationStatus::AlreadyEnrolled:
+            return "Duplicate student enrollment: '" + studentID + " in " + courseCode + "' already exists";
+        case RegistrationStatus::NotEnrolled:
+            return "Student not enrolled in " + courseCode;
+        case RegistrationStatus::CourseFull:
+            return "Course " + seat + " is full. No seats available.";
+        case RegistrationStatus::TimeConflict:
+            return "Time conflict: " + courseCode + " conflicts with " + conflictingCourse + " on " + conflictDay;
+        case RegistrationStatus::MissingPrerequisite:
+        case RegistrationStatus::MissingCorequisite:
+            return PrerequisiteException::message(courseCode, missingCourse.str(),
+                                                  status == RegistrationStatus::MissingCorequisite);
+        case RegistrationStatus::RuleViolation:
+            return RuleViolationException::message(courseCode, ruleName, ruleText);
+        case RegistrationStatus::TryLater:
+            return TryLaterException::message(courseCode, retryAfterMs);
+    }
+    return "";
+}
+
+void CancellationReport::print(std::ostream& out) const {
+    out << "\n--- " << (sectionID.empty() ? "Removed " + course : "Cancelled " + course + " section " + sectionID)
+        << " ---\n";
+    out << displaced.size() << " student(s) lost their seat";
+    if (!alternativeCode.empty()) out << "; " << placed << " placed in " << alternativeCode;
+    out << "\n";
+    for (const auto& student : displaced) {
+        out << "  " << student.studentID << " (section " << student.sectionID << ")";
+        if (student.placementTried) {
+            if (student.placement.ok()) out << " -> " << alternativeCode << " section " << student.placement.sectionID;
+            else out << " -> not placed: " << student.placement.message();
+        }
+        out << "\n";
+    }
+}
+
+void ScheduleImpact::print(std::ostream& out) const {
+    out << "\n--- " << (applied ? "Changed " : "Impact of changing ") << course << " section " << sectionID << " ---\n";
+    out << enrolled << " enrolled, capacity " << capacity;
+    if (overCapacity > 0) out << " (" << overCapacity << " over)";
+    out << "; " << conflicts << " new time conflict(s)\n";
+    if (applied) out << moved << " moved to another section, " << dropped << " dropped\n";
+    for (const auto& student : affected) {
+        out << "  " << student.studentID << ":";
+        if (student.overCapacity) out << " over capacity";
+        if (!student.conflictingCourse.empty()) {
+            out << " conflicts with " << student.conflictingCourse << " on " << student.conflictDay;
+        }
+        if (student.action == AffectedStudent::Moved) out << " -> moved to section " << student.alternativeSection;
+        else if (student.action == AffectedStudent::Dropped) out << " -> dropped";
+        else if (student.action == AffectedStudent::Kept) out << " -> kept";
+        else if (!student.alternativeSection.empty()) out << " (section " << student.alternativeSection << " is open)";
+        else out << " (no open section without a conflict)";
+        out << "\n";
+    }
+}
@@ -4,55 +4,521 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <utility>
+
+// Fields of one students.txt line, parsed off the main thread
+struct RegistrationSystem::StudentRecord {
+    std::string username, password, email, name, userID, major;
+    StudentId studentID;
+    double gpa = 0.0;
+    std::vector<CourseCode> courses;
+    std::vector<CourseCode> completed;
+};
 
 RegistrationSystem::RegistrationSystem(const std::string& studentsFilePath, const std::string& coursesFilePath)
-    : studentsFilePath(studentsFilePath), coursesFilePath(coursesFilePath) {}
+    : studentsFilePath(studentsFilePath), coursesFilePath(coursesFilePath), prerequisitesDirty(false),
+      eventLog(enrollmentLogPath()), courseShards(coursesFilePath), studentShards(studentsFilePath),
+      dirtyCourseShards(1, 0), dirtyStudentShards(1, 0), lazyStudents(false), studentCacheCapacity(0),
+      allocationWindowOpen(false), exportFailed(false) {}
+
+RegistrationSystem::~RegistrationSystem() {
+    if (exportWorker.joinable()) exportWorker.join();
+}
 
 void RegistrationSystem::loadData() {
+    loadShardCount();
+    loadTerms();
     loadCourses();
+    prerequisites.load(prerequisitesFilePath());
+    prerequisitesDirty = false;
+    try {
+        rules = RuleSet::load(rulesFilePath());
+    } catch (const InvalidInputException& e) {
+        std::cout << "Registration rules not loaded: " << e.what() << std::endl;
+        rules = RuleSet();
+    }
     loadStudents();
 }
 
 void RegistrationSystem::saveData() const {
+    saveTerms();
+    if (prerequisitesDirty) {
+        prerequisites.save(prerequisitesFilePath());
+        prerequisitesDirty = false;
+    }
     saveCourses();
     saveStudents();
+    eventLog.flush();
 }
 
-const std::vector<Course>& RegistrationSystem::getCourses() const {
-    return courses;
+CatalogReader RegistrationSystem::getCourses() const {
+    return snapshots.read();
 }
 
-const std::vector<Student>& RegistrationSystem::getStudents() const {
+const StudentStore& RegistrationSystem::getStudents() const {
     return students;
 }
 
-Course* RegistrationSystem::findCourse(const std::string& code) {
-    auto it = std::find_if(courses.begin(), courses.end(), [&](const Course& c) {
-        return c.getCode() == code;
-    });
-    return it == courses.end() ? nullptr : &(*it);
+SlabHandle RegistrationSystem::getStudentHandle(const std::string& username) const {
+    auto it = studentIndex.find(username);
+    return it == studentIndex.end() ? SlabHandle() : it->second;
+}
+
+Student* RegistrationSystem::getStudent(SlabHandle handle) {
+    return students.get(handle);
+}
+
+const Course* RegistrationSystem::getCourse(std::string_view code) const {
+    return const_cast<RegistrationSystem*>(this)->findCourse(code);
+}
+
+Course* RegistrationSystem::findCourse(std::string_view code) {
+    // Text that cannot be a course code is simply not found
+    CourseCode key;
+    if (!CourseCode::tryParse(code, key)) return nullptr;
+    auto it = courseIndex.find(key);
+    return it == courseIndex.end() ? nullptr : courses.get(it->second);
+}
+
+Course& RegistrationSystem::requireCourse(const std::string& code) {
+    Course* course = findCourse(code);
+    if (!course) {
+        throw RegistrationException("Course not found: " + code);
+    }
+    return *course;
+}
+
+void RegistrationSystem::rebuildCourseIndex() {
+    courseIndex.clear();
+    courseIndex.reserve(courses.size());
+    for (auto it = courses.begin(); it != courses.end(); ++it) {
+        courseIndex[it->getCode()] = it.handle();
+    }
+}
+
+void RegistrationSystem::addCourse(const Course& course) {
+    if (findCourse(course.getCode()) != nullptr) {
+        throw DuplicateEntryException("course code", course.getCode().str());
+    }
+    SlabHandle handle = courses.emplace(course);
+    courseIndex[course.getCode()] = handle;
+    markCourseDirty(course.getCode());
+    catalogView.invalidate();
+    snapshots.publishCourse(*courses.get(handle));
+    seatWatches.onCourseAdded(*courses.get(handle));
+    logEvent(EnrollmentOp::CourseAdded, course.getCode());
+}
+
+CancellationReport RegistrationSystem::removeCourse(const std::string& code, const std::string& alternativeCode) {
+    CourseCode key;
+    auto it = CourseCode::tryParse(code, key) ? courseIndex.find(key) : courseIndex.end();
+    if (it == courseIndex.end()) {
+        throw RegistrationException("Course not found: " + code);
+    }
+    if (!alternativeCode.empty() && (alternativeCode == code || !findCourse(alternativeCode))) {
+        throw RegistrationException("Alternative course not found: " + alternativeCode);
+    }
+    Course* course = courses.get(it->second);
+    CancellationReport report;
+    report.course = key;
+    report.alternativeCode = alternativeCode;
+
+    std::vector<uint32_t> pinned;
+    std::vector<Student*> affected;
+    try {
+        for (const auto& section : course->getSections()) {
+            std::vector<Student*> roster = gatherRoster(section, report, pinned);
+            affected.insert(affected.end(), roster.begin(), roster.end());
+        }
+    } catch (...) {
+        releaseRoster(pinned);
+        throw;
+    }
+
+    revokeSeats(key, affected, report);
+    logEvent(EnrollmentOp::CourseRemoved, key);
+    courses.erase(it->second);
+    courseIndex.erase(it);
+    prerequisites.removeCourse(key);
+    prerequisitesDirty = true;
+    markCourseDirty(code);
+    catalogView.invalidate();
+    snapshots.withdrawCourse(key);
+    seatWatches.onCourseRemoved(key);
+
+    placeDisplaced(affected, report);
+    releaseRoster(pinned);
+    saveData();
+    return report;
+}
+
+CancellationReport RegistrationSystem::cancelSection(const std::string& code, const std::string& sectionID,
+                                                     const std::string& alternativeCode) {
+    Course& course = requireCourse(code);
+    const Section* section = sectionID.empty() ? nullptr : course.findSection(sectionID);
+    if (!section) {
+        throw RegistrationException("Section " + sectionID + " not found in " + code);
+    }
+    if (course.getSections().size() == 1) {
+        throw RegistrationException("Cannot cancel the only section of " + code + "; remove the course instead");
+    }
+    if (!alternativeCode.empty() && !findCourse(alternativeCode)) {
+        throw RegistrationException("Alternative course not found: " + alternativeCode);
+    }
+    CancellationReport report;
+    report.course = course.getCode();
+    report.sectionID = sectionID;
+    report.alternativeCode = alternativeCode;
+
+    std::vector<uint32_t> pinned;
+    std::vector<Student*> affected;
+    try {
+        affected = gatherRoster(*section, report, pinned);
+    } catch (...) {
+        releaseRoster(pinned);
+        throw;
+    }
+
+    revokeSeats(course.getCode(), affected, report);
+    course.removeSection(sectionID);
+    logEvent(EnrollmentOp::SectionCancelled, course.getCode(), StudentId(), sectionID);
+    markCourseDirty(code);
+    catalogView.invalidate();
+    snapshots.publishCourse(course);
+    seatWatches.onSeatsChanged(course);
+
+    placeDisplaced(affected, report);
+    releaseRoster(pinned);
+    saveData();
+    return report;
+}
+
+std::vector<Student*> RegistrationSystem::gatherRoster(const Section& section, CancellationReport& report,
+                                                       std::vector<uint32_t>& pinned) {
+    std::vector<Student*> roster;
+    roster.reserve(section.getEnrolledStudentIDs().size());
+    for (const auto& id : section.getEnrolledStudentIDs()) {
+        Student* student = findStudent(id);   // nullptr if the roster names a missing record
+        if (student && lazyStudents) {
+            uint32_t slot = studentIDIndex.at(id).index;
+            studentDirectory.pin(slot);
+            pinned.push_back(slot);
+        }
+        roster.push_back(student);
+        DisplacedStudent displaced;
+        displaced.studentID = id;
+        displaced.sectionID = section.getSectionID();
+        report.displaced.push_back(std::move(displaced));
+    }
+    return roster;
+}
+
+void RegistrationSystem::releaseRoster(const std::vector<uint32_t>& pinned) {
+    for (uint32_t slot : pinned) studentDirectory.unpin(slot);
+    if (lazyStudents && !pinned.empty()) evictStudents(UINT32_MAX);
+}
+
+void RegistrationSystem::revokeSeats(CourseCode code, const std::vector<Student*>& affected,
+                                     const CancellationReport& report) {
+    for (size_t i = 0; i < affected.size(); ++i) {
+        Student* student = affected[i];
+        if (student && student->isEnrolledIn(code)) {
+            student->removeCourse(code);
+            markStudentDirty(*student);
+        }
+        logEvent(EnrollmentOp::SeatRevoked, code, report.displaced[i].studentID, report.displaced[i].sectionID);
+    }
+}
+
+void RegistrationSystem::placeDisplaced(const std::vector<Student*>& affected, CancellationReport& report) {
+    if (report.alternativeCode.empty()) return;
+    for (size_t i = 0; i < affected.size(); ++i) {
+        if (!affected[i]) continue;
+        DisplacedStudent& displaced = report.displaced[i];
+        displaced.placementTried = true;
+        displaced.placement = tryRegisterForCourse(*affected[i], report.alternativeCode);
+        if (displaced.placement.ok()) {
+            ++report.placed;
+            const Course* alternative = findCourse(report.alternativeCode);
+            displaced.placement.sectionID = alternative->findSectionOf(displaced.studentID)->getSectionID();
+        }
+    }
+}
+
+void RegistrationSystem::setCourseTitle(const std::string& code, const std::string& title) {
+    Course& course = requireCourse(code);
+    course.setCourseName(title);
+    markCourseDirty(code);
+    catalogView.invalidate();
+    snapshots.publishCourse(course);
+    seatWatches.onSeatsChanged(course);
+    logEvent(EnrollmentOp::TitleChanged, course.getCode());
+}
+
+void RegistrationSystem::setCourseCapacity(const std::string& code, int capacity, const std::string& sectionID) {
+    Course& course = requireCourse(code);
+    Section* section = course.findSection(sectionID);
+    if (!section) {
+        throw RegistrationException("Section " + sectionID + " not found in " + code);
+    }
+    int enrolled = static_cast<int>(section->getEnrolledStudentIDs().size());
+    if (capacity < enrolled) {
+        throw RegistrationException("Capacity " + std::to_string(capacity) + " is below the " +
+                                    std::to_string(enrolled) + " students already enrolled");
+    }
+    section->setCapacity(capacity);
+    markCourseDirty(code);
+    catalogView.onSeatsChanged(*section);
+    snapshots.publishCourse(course);
+    seatWatches.onSeatsChanged(course);
+    logEvent(EnrollmentOp::CapacityChanged, course.getCode(), StudentId(), section->getSectionID());
+}
+
+void RegistrationSystem::setCourseMeetings(const std::string& code, const std::vector<Meeting>& meetings,
+                                           const std::string& sectionID) {
+    Course& course = requireCourse(code);
+    course.setMeetings(meetings, sectionID);
+    markCourseDirty(code);
+    catalogView.invalidate();
+    snapshots.publishCourse(course);
+    seatWatches.onSeatsChanged(course);
+    logEvent(EnrollmentOp::MeetingsChanged, course.getCode(), StudentId(), course.findSection(sectionID)->getSectionID());
+}
+
+void RegistrationSystem::addCourseSection(const std::string& code, const Section& section) {
+    Course& course = requireCourse(code);
+    course.addSection(section);
+    markCourseDirty(code);
+    catalogView.invalidate();
+    snapshots.publishCourse(course);
+    seatWatches.onSeatsChanged(course);
+    logEvent(EnrollmentOp::SectionAdded, course.getCode(), StudentId(), section.getSectionID());
+}
+
+ScheduleImpact RegistrationSystem::computeImpact(Course& course, Section& section, const ScheduleChange& change,
+                                                 ImpactResolution resolution,
+                                                 std::vector<Student*>& records, std::vector<uint32_t>& pinned) {
+    ScheduleImpact impact;
+    impact.course = course.getCode();
+    impact.sectionID = section.getSectionID();
+    const auto& roster = section.getEnrolledStudentIDs();
+    impact.enrolled = static_cast<int>(roster.size());
+    impact.capacity = change.capacity >= 0 ? change.capacity : section.getCapacity();
+
+    std::vector<Meeting> meetings = change.changeMeetings ? change.meetings : section.getMeetings();
+    std::sort(meetings.begin(), meetings.end(),
+              [](const Meeting& a, const Meeting& b) { return a.weekStart < b.weekStart; });
+    // Seats the other sections can give, used up as alternatives are suggested
+    std::vector<int> seatsLeft;
+    for (const auto& other : course.getSections()) seatsLeft.push_back(other.seatsRemaining());
+
+    struct Candidate {
+        Student* student = nullptr;   // Pinned in lazy mode once looked up
+        AffectedStudent affected;
+        bool listed = false;          // New conflict or over capacity
+        bool leaves = false;          // Moves or is dropped for a conflict under the resolution
+    };
+    std::vector<Candidate> candidates(roster.size());
+
+    auto hold = [&](size_t i) -> Student* {
+        Candidate& candidate = candidates[i];
+        if (!candidate.student) {
+            candidate.student = findStudent(roster[i]);
+            if (candidate.student && lazyStudents) {
+                uint32_t slot = studentIDIndex.at(roster[i]).index;
+                studentDirectory.pin(slot);
+                pinned.push_back(slot);
+            }
+        }
+        return candidate.student;
+    };
+    // Open, conflict-free section of the same course; takes one of its seats
+    RuleContext context;
+    auto findAlternative = [&](Student& student) -> std::string {
+        buildSchedule(student, course.getCode());
+        if (!rules.empty()) fillRuleContext(student, course.getCode(), course.getCode(), context);
+        const auto& sections = course.getSections();
+        for (size_t k = 0; k < sections.size(); ++k) {
+            if (&sections[k] == &section || seatsLeft[k] <= 0) continue;
+            if (!rules.empty()) {
+                context.section = sections[k].getSectionID();
+                if (rules.firstViolation(context) >= 0) continue;
+            }
+            if (Section::findOverlap(scheduleScratch, sections[k].getMeetings()) >= 0) continue;
+            --seatsLeft[k];
+            return sections[k].getSectionID();
+        }
+        return "";
+    };
+
+    // New conflicts first: under the move policies those students leave the
+    // section, which can bring the rest of the roster back under capacity
+    if (change.changeMeetings) {
+        for (size_t i = 0; i < roster.size(); ++i) {
+            Student* student = findStudent(roster[i]);
+            if (!student) continue;
+            buildSchedule(*student, course.getCode());
+            int overlap = Section::findOverlap(scheduleScratch, meetings);
+            if (overlap < 0) continue;
+
+            Candidate& candidate = candidates[i];
+            candidate.listed = true;
+            candidate.affected.conflictingCourse = scheduleOwners[overlap];
+            candidate.affected.conflictDay = scheduleScratch[overlap].dayOfWeek;
+            ++impact.conflicts;
+            student = hold(i);
+            if (student && resolution != ImpactResolution::KeepConflicts) {
+                candidate.affected.alternativeSection = findAlternative(*student);
+                candidate.leaves = !candidate.affected.alternativeSection.empty() ||
+                                   resolution == ImpactResolution::MoveOrDrop;
+            }
+        }
+    }
+
+    // Of the students who stay, the most recently enrolled are over capacity
+    int staying = 0;
+    for (size_t i = 0; i < roster.size(); ++i) {
+        Candidate& candidate = candidates[i];
+        if (candidate.leaves || staying++ < impact.capacity) continue;
+        candidate.listed = true;
+        candidate.affected.overCapacity = true;
+        ++impact.overCapacity;
+        Student* student = hold(i);
+        if (student && candidate.affected.alternativeSection.empty()) {
+            candidate.affected.alternativeSection = findAlternative(*student);
+        }
+    }
+
+    // Conflicts that keep their seat get a suggestion from what is left
+    if (resolution == ImpactResolution::KeepConflicts) {
+        for (size_t i = 0; i < roster.size(); ++i) {
+            Candidate& candidate = candidates[i];
+            if (!candidate.listed || candidate.affected.overCapacity || !candidate.student) continue;
+            candidate.affected.alternativeSection = findAlternative(*candidate.student);
+        }
+    }
+
+    for (size_t i = 0; i < roster.size(); ++i) {
+        Candidate& candidate = candidates[i];
+        if (!candidate.listed) continue;
+        candidate.affected.studentID = roster[i];
+        records.push_back(candidate.student);
+        impact.affected.push_back(std::move(candidate.affected));
+    }
+    return impact;
+}
+
+ScheduleImpact RegistrationSystem::analyzeScheduleChange(const std::string& code, const std::string& sectionID,
+                                                         const ScheduleChange& change, ImpactResolution resolution) {
+    Course& course = requireCourse(code);
+    Section* section = course.findSection(sectionID);
+    if (!section) {
+        throw RegistrationException("Section " + sectionID + " not found in " + code);
+    }
+    std::vector<Student*> records;
+    std::vector<uint32_t> pinned;
+    ScheduleImpact impact = computeImpact(course, *section, change, resolution, records, pinned);
+    releaseRoster(pinned);
+    return impact;
+}
+
+ScheduleImpact RegistrationSystem::applyScheduleChange(const std::string& code, const std::string& sectionID,
+                                                       const ScheduleChange& change, ImpactResolution resolution) {
+    Course& course = requireCourse(code);
+    Section* section = course.findSection(sectionID);
+    if (!section) {
+        throw RegistrationException("Section " + sectionID + " not found in " + code);
+    }
+    std::vector<Student*> records;
+    std::vector<uint32_t> pinned;
+    ScheduleImpact impact = computeImpact(course, *section, change, resolution, records, pinned);
+    CourseCode key = course.getCode();
+
+    // Seats move before the section changes; over-capacity students cannot stay
+    for (size_t i = 0; i < impact.affected.size(); ++i) {
+        AffectedStudent& affected = impact.affected[i];
+        bool mayMove = affected.overCapacity || resolution != ImpactResolution::KeepConflicts;
+        bool mustLeave = affected.overCapacity || resolution == ImpactResolution::MoveOrDrop;
+        if (mayMove && !affected.alternativeSection.empty()) {
+            Section* target = course.findSection(affected.alternativeSection);
+            target->enrollStudent(affected.studentID, key);
+            section->dropStudent(affected.studentID, key);
+            logEvent(EnrollmentOp::SwappedOut, key, affected.studentID, section->getSectionID());
+            logEvent(EnrollmentOp::SwappedIn, key, affected.studentID, target->getSectionID());
+            affected.action = AffectedStudent::Moved;
+            ++impact.moved;
+        } else if (mustLeave) {
+            section->dropStudent(affected.studentID, key);
+            if (records[i]) {
+                records[i]->removeCourse(key);
+                markStudentDirty(*records[i]);
+            }
+            logEvent(EnrollmentOp::SeatRevoked, key, affected.studentID, section->getSectionID());
+            affected.action = AffectedStudent::Dropped;
+            ++impact.dropped;
+        } else {
+            affected.action = AffectedStudent::Kept;
+        }
+    }
+    if (change.capacity >= 0) section->setCapacity(change.capacity);
+    if (change.changeMeetings) course.setMeetings(change.meetings, section->getSectionID());
+    impact.applied = true;
+
+    markCourseDirty(code);
+    catalogView.invalidate();
+    snapshots.publishCourse(course);
+    seatWatches.onSeatsChanged(course);
+    if (change.capacity >= 0) logEvent(EnrollmentOp::CapacityChanged, key, StudentId(), section->getSectionID());
+    if (change.changeMeetings) logEvent(EnrollmentOp::MeetingsChanged, key, StudentId(), section->getSectionID());
+    releaseRoster(pinned);
+    return impact;
 }
 
 Student* RegistrationSystem::findStudent(const std::string& username) {
-    auto it = std::find_if(students.begin(), students.end(), [&](const Student& s) {
-        return s.getUsername() == username;
-    });
-    return it == students.end() ? nullptr : &(*it);
+    auto it = studentIndex.find(username);
+    if (it != studentIndex.end()) {
+        if (lazyStudents) studentDirectory.touch(it->second.index);
+        return students.get(it->second);
+    }
+    if (!lazyStudents) return nullptr;
+
+    // Not resident: a directory miss answers without touching the disk
+    for (const auto& location : studentDirectory.findUsername(username)) {
+        StudentRecord record;
+        if (readStudentAt(location, record) && record.username == username) {
+            return addResidentStudent(record);
+        }
+    }
+    return nullptr;
 }
 
-Student& RegistrationSystem::createStudent(const std::string& username,
-                                           const std::string& password,
-                                           const std::string& email,
-                                           const std::string& name,
-                                           const std::string& userID,
-                                           const std::string& studentID,
-                                           const std::string& major,
+Student& RegistrationSystem::createStudent(std::string username,
+                                           std::string password,
+                                           std::string email,
+                                           std::string name,
+                                           std::string userID,
+                                           std::string studentID,
+                                           std::string major,
                                            double gpa) {
     if (findStudent(username) != nullptr) {
         throw DuplicateEntryException("username", username);
     }
-    students.emplace_back(username, password, email, name, userID, studentID, major, gpa);
-    return students.back();
+    StudentId id(studentID);   // Throws before anything is stored if the ID does not fit
+    SlabHandle handle = students.emplace(std::move(username), std::move(password), std::move(email),
+                                         std::move(name), std::move(userID), id,
+                                         std::move(major), gpa);
+    Student* student = students.get(handle);
+    studentIndex[student->getUsername()] = handle;
+    studentIDIndex[id] = handle;
+    markStudentDirty(*student);
+    if (lazyStudents) {
+        studentDirectory.touch(handle.index);
+        evictStudents(handle.index);
+    }
+    return *student;
 }
 
 Student* RegistrationSystem::login(const std::string& username, const std::string& password) {
@@ -63,181 +529,1590 @@ Student* RegistrationSystem::login(const std::string& username, const std::strin
     if (student->getPassword() != password) {
         throw AuthenticationException("Incorrect password");
     }
+    // Keep the record resident while the session holds the pointer
+    if (lazyStudents) studentDirectory.pin(studentIndex[student->getUsername()].index);
     return student;
 }
 
-void RegistrationSystem::registerForCourse(Student& student, const std::string& courseCode) {
+void RegistrationSystem::logout(const Student& student) {
+    if (!lazyStudents) return;
+    auto it = studentIndex.find(student.getUsername());
+    if (it == studentIndex.end()) return;
+    studentDirectory.unpin(it->second.index);
+    evictStudents(UINT32_MAX);
+}
+
+// Fills the reusable scratch buffers, so steady-state registration does not allocate
+void RegistrationSystem::buildSchedule(const Student& student, CourseCode excluded) {
+    scheduleOrder.clear();
+    for (const auto& enrolledCode : student.getEnrolledCourses()) {
+        if (enrolledCode == excluded) continue;
+        const Course* enrolledCourse = getCourse(enrolledCode);
+        if (!enrolledCourse) continue;
+        const Section* section = enrolledCourse->findSectionOf(student.getStudentID());
+        if (!section) continue;
+        for (const auto& meeting : section->getMeetings()) {
+            scheduleOrder.emplace_back(&meeting, enrolledCourse->getCode());
+        }
+    }
+    std::sort(scheduleOrder.begin(), scheduleOrder.end(), [](const auto& a, const auto& b) {
+        return a.first->weekStart < b.first->weekStart;
+    });
+
+    scheduleScratch.clear();
+    scheduleOwners.clear();
+    for (const auto& entry : scheduleOrder) {
+        scheduleScratch.push_back(*entry.first);
+        scheduleOwners.push_back(entry.second);
+    }
+}
+
+RegistrationResult RegistrationSystem::tryRegisterForCourse(Student& student, const std::string& courseCode,
+                                                            const std::string& sectionID) {
+    RegistrationResult result;
+    result.courseCode = courseCode;
+    result.sectionID = sectionID;
+
     Course* course = findCourse(courseCode);
     if (!course) {
-        throw RegistrationException("Course " + courseCode + " not found");
+        result.status = RegistrationStatus::CourseNotFound;
+        return result;
+    }
+    if (course->isStudentEnrolled(student.getStudentID()) || student.isEnrolledIn(course->getCode())) {
+        result.status = RegistrationStatus::AlreadyEnrolled;
+        result.studentID = student.getStudentID();
+        return result;
+    }
+    if (!checkEligibility(student, course->getCode(), student.getEnrolledCourses(), result)) {
+        return result;
+    }
+
+    // Student's meetings, sorted once; each candidate section is checked with a linear merge
+    buildSchedule(student);
+    const std::vector<Meeting>& schedule = scheduleScratch;
+
+    RuleContext context;
+    if (!rules.empty()) fillRuleContext(student, course->getCode(), CourseCode(), context);
+
+    Section* chosen = nullptr;
+    int conflictIndex = -1;
+    int violatedRule = -1;
+    bool sawOpenSeat = false;
+
+    for (const auto& candidate : course->getSections()) {
+        if (!sectionID.empty() && candidate.getSectionID() != sectionID) continue;
+        if (candidate.seatsRemaining() <= 0) continue;
+        sawOpenSeat = true;
+
+        if (!rules.empty()) {
+            context.section = candidate.getSectionID();
+            int violated = rules.firstViolation(context);
+            if (violated >= 0) {
+                if (violatedRule < 0) violatedRule = violated;
+                continue;
+            }
+        }
+
+        int overlap = Section::findOverlap(schedule, candidate.getMeetings());
+        if (overlap < 0) {
+            chosen = course->findSection(candidate.getSectionID());
+            break;
+        }
+        if (conflictIndex < 0) conflictIndex = overlap;
     }
-    
-    // Check for time conflicts with already enrolled courses
-    const auto& enrolledCourseCodes = student.getEnrolledCourses();
-    for (const auto& enrolledCode : enrolledCourseCodes) {
-        Course* enrolledCourse = findCourse(enrolledCode);
-        if (enrolledCourse && course->hasTimeConflict(*enrolledCourse)) {
-            throw TimeConflictException(courseCode, enrolledCode, course->getDayOfWeek());
+
+    if (!chosen) {
+        if (!sectionID.empty() && course->findSection(sectionID) == nullptr) {
+            result.status = RegistrationStatus::SectionNotFound;
+        } else if (!sawOpenSeat) {
+            result.status = RegistrationStatus::CourseFull;
+        } else if (conflictIndex < 0) {
+            setRuleViolation(violatedRule, result);
+        } else {
+            result.status = RegistrationStatus::TimeConflict;
+            result.conflictingCourse = scheduleOwners[conflictIndex];
+            result.conflictDay = schedule[conflictIndex].dayOfWeek;
         }
+        return result;
     }
-    
+
     // If no conflicts, proceed with enrollment
-    course->enrollStudent(student.getStudentID());
-    student.addCourse(courseCode);
+    chosen->enrollStudent(student.getStudentID(), course->getCode());
+    student.addCourse(course->getCode());
+    markCourseDirty(courseCode);
+    markStudentDirty(student);
+    catalogView.onSeatsChanged(*chosen);
+    snapshots.publishCourse(*course);
+    seatWatches.onSeatsChanged(*course);
+    logEvent(EnrollmentOp::Registered, course->getCode(), student.getStudentID(), chosen->getSectionID());
+    return result;
 }
 
-void RegistrationSystem::dropCourse(Student& student, const std::string& courseCode) {
+void RegistrationSystem::registerForCourse(Student& student, const std::string& courseCode, const std::string& sectionID) {
+    tryRegisterForCourse(student, courseCode, sectionID).raise();
+}
+
+RegistrationResult RegistrationSystem::tryDropCourse(Student& student, const std::string& courseCode) {
+    RegistrationResult result;
+    result.courseCode = courseCode;
+
     Course* course = findCourse(courseCode);
     if (!course) {
-        throw RegistrationException("Course " + courseCode + " not found");
+        result.status = RegistrationStatus::CourseNotFound;
+        return result;
+    }
+    Section* section = course->findSectionOf(student.getStudentID());
+    if (!section) {
+        result.status = RegistrationStatus::NotEnrolled;
+        return result;
     }
-    course->dropStudent(student.getStudentID());
-    student.removeCourse(courseCode);
+    section->dropStudent(student.getStudentID(), course->getCode());
+    student.removeCourse(course->getCode());
+    markCourseDirty(courseCode);
+    markStudentDirty(student);
+    catalogView.onSeatsChanged(*section);
+    snapshots.publishCourse(*course);
+    seatWatches.onSeatsChanged(*course);
+    logEvent(EnrollmentOp::Dropped, course->getCode(), student.getStudentID(), section->getSectionID());
+    return result;
 }
 
-void RegistrationSystem::listCourses() const {
-    std::cout << "\n=====================================" << std::endl;
-    std::cout << "      AVAILABLE COURSES              " << std::endl;
-    std::cout << "=====================================" << std::endl;
-    for (const auto& course : courses) {
-        std::cout << "Code: " << course.getCode() << std::endl;
-        std::cout << "Title: " << course.getTitle() << std::endl;
-        std::cout << "Capacity: " << course.getCapacity() 
-                  << " | Seats Remaining: " << course.seatsRemaining() << std::endl;
-        if (!course.getDayOfWeek().empty()) {
-            std::cout << "Schedule: " << course.getDayOfWeek() 
-                      << " " << course.getStartTime() 
-                      << " - " << course.getEndTime() << std::endl;
+void RegistrationSystem::dropCourse(Student& student, const std::string& courseCode) {
+    tryDropCourse(student, courseCode).raise();
+}
+
+RegistrationResult RegistrationSystem::trySwapCourse(Student& student, const std::string& fromCode,
+                                                     const std::string& toCode, const std::string& toSectionID) {
+    RegistrationResult result;
+    result.courseCode = fromCode;
+
+    // ---- Validate both sides before touching any roster ----
+    Course* fromCourse = findCourse(fromCode);
+    if (!fromCourse) {
+        result.status = RegistrationStatus::CourseNotFound;
+        return result;
+    }
+    Section* fromSection = fromCourse->findSectionOf(student.getStudentID());
+    if (!fromSection) {
+        result.status = RegistrationStatus::NotEnrolled;
+        return result;
+    }
+
+    result.courseCode = toCode;
+    result.sectionID = toSectionID;
+    Course* toCourse = findCourse(toCode);
+    if (!toCourse) {
+        result.status = RegistrationStatus::CourseNotFound;
+        return result;
+    }
+    bool sameCourse = toCourse == fromCourse;
+    if (sameCourse ? toSectionID == fromSection->getSectionID()
+                   : toCourse->isStudentEnrolled(student.getStudentID()) || student.isEnrolledIn(toCourse->getCode())) {
+        result.status = RegistrationStatus::AlreadyEnrolled;
+        result.studentID = student.getStudentID();
+        return result;
+    }
+    if (!sameCourse) {
+        // Corequisites may be met by the other current courses, not the one being dropped
+        swapEnrolled.assign(student.getEnrolledCourses().begin(), student.getEnrolledCourses().end());
+        swapEnrolled.erase(std::remove(swapEnrolled.begin(), swapEnrolled.end(), fromCourse->getCode()),
+                           swapEnrolled.end());
+        if (!checkEligibility(student, toCourse->getCode(), swapEnrolled, result)) {
+            return result;
+        }
+    }
+
+    // Schedule without the course being dropped, so its seat and times count as free
+    buildSchedule(student, fromCourse->getCode());
+    const std::vector<Meeting>& schedule = scheduleScratch;
+
+    RuleContext context;
+    if (!rules.empty()) fillRuleContext(student, toCourse->getCode(), fromCourse->getCode(), context);
+
+    Section* chosen = nullptr;
+    int conflictIndex = -1;
+    int violatedRule = -1;
+    bool sawOpenSeat = false;
+
+    for (const auto& candidate : toCourse->getSections()) {
+        if (!toSectionID.empty() && candidate.getSectionID() != toSectionID) continue;
+        if (&candidate == fromSection) continue;
+        if (candidate.seatsRemaining() <= 0) continue;
+        sawOpenSeat = true;
+
+        if (!rules.empty()) {
+            context.section = candidate.getSectionID();
+            int violated = rules.firstViolation(context);
+            if (violated >= 0) {
+                if (violatedRule < 0) violatedRule = violated;
+                continue;
+            }
+        }
+
+        int overlap = Section::findOverlap(schedule, candidate.getMeetings());
+        if (overlap < 0) {
+            chosen = toCourse->findSection(candidate.getSectionID());
+            break;
+        }
+        if (conflictIndex < 0) conflictIndex = overlap;
+    }
+
+    if (!chosen) {
+        if (!toSectionID.empty() && toCourse->findSection(toSectionID) == nullptr) {
+            result.status = RegistrationStatus::SectionNotFound;
+        } else if (!sawOpenSeat) {
+            result.status = RegistrationStatus::CourseFull;
+        } else if (conflictIndex < 0) {
+            setRuleViolation(violatedRule, result);
+        } else {
+            result.status = RegistrationStatus::TimeConflict;
+            result.conflictingCourse = scheduleOwners[conflictIndex];
+            result.conflictDay = schedule[conflictIndex].dayOfWeek;
         }
-        std::cout << "-------------------------------------" << std::endl;
+        return result;
     }
-    std::cout << std::endl;
+
+    // ---- Commit: the add is the only step that can throw, so it goes first ----
+    chosen->enrollStudent(student.getStudentID(), toCourse->getCode());
+    fromSection->dropStudent(student.getStudentID(), fromCourse->getCode());
+    student.replaceCourse(fromCourse->getCode(), toCourse->getCode());
+
+    markCourseDirty(fromCourse->getCode());
+    markCourseDirty(toCourse->getCode());
+    markStudentDirty(student);
+    catalogView.onSeatsChanged(*fromSection);
+    catalogView.onSeatsChanged(*chosen);
+    snapshots.publishCourses({fromCourse, toCourse == fromCourse ? nullptr : toCourse});
+    seatWatches.onSeatsChanged(*fromCourse);
+    if (toCourse != fromCourse) seatWatches.onSeatsChanged(*toCourse);
+    logEvent(EnrollmentOp::SwappedOut, fromCourse->getCode(), student.getStudentID(), fromSection->getSectionID());
+    logEvent(EnrollmentOp::SwappedIn, toCourse->getCode(), student.getStudentID(), chosen->getSectionID());
+    return result;
 }
 
-std::vector<std::string> RegistrationSystem::split(const std::string& input, char delimiter) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(input);
-    std::string item;
-    while (std::getline(ss, item, delimiter)) {
-        if (!item.empty()) {
-            tokens.push_back(item);
+void RegistrationSystem::swapCourse(Student& student, const std::string& fromCode, const std::string& toCode,
+                                    const std::string& toSectionID) {
+    trySwapCourse(student, fromCode, toCode, toSectionID).raise();
+}
+
+void RegistrationSystem::openAllocationWindow() {
+    if (allocationWindowOpen) {
+        throw RegistrationException("Allocation window is already open");
+    }
+    allocationWindowOpen = true;
+    pendingRequests.clear();
+}
+
+bool RegistrationSystem::isAllocationWindowOpen() const {
+    return allocationWindowOpen;
+}
+
+void RegistrationSystem::submitSeatRequest(const Student& student, const std::vector<SeatChoice>& rankedChoices) {
+    if (!allocationWindowOpen) {
+        throw RegistrationException("Allocation window is not open");
+    }
+    if (rankedChoices.empty()) {
+        throw InvalidInputException("seat request", "", "at least one course is required");
+    }
+    // Corequisites may be met by current courses or by the other choices
+    std::vector<CourseCode> taking = student.getEnrolledCourses();
+    for (const auto& choice : rankedChoices) {
+        const Course* course = findCourse(choice.courseCode);
+        if (!course) {
+            throw RegistrationException("Course " + choice.courseCode + " not found");
         }
+        taking.push_back(course->getCode());
+    }
+    for (const auto& choice : rankedChoices) {
+        RegistrationResult result;
+        result.courseCode = choice.courseCode;
+        if (!checkEligibility(student, findCourse(choice.courseCode)->getCode(), taking, result)) {
+            result.raise();
+        }
+    }
+    pendingRequests.push_back(SeatRequest{student.getStudentID().str(), rankedChoices});
+    for (const auto& choice : rankedChoices) {
+        logEvent(EnrollmentOp::SeatRequested, findCourse(choice.courseCode)->getCode(), student.getStudentID(),
+                 choice.sectionID);
     }
-    return tokens;
 }
 
-void RegistrationSystem::loadCourses() {
-    std::ifstream file(coursesFilePath);
-    if (!file.is_open()) {
-        std::cout << "No course file found. Starting with sample courses." << std::endl;
+size_t RegistrationSystem::pendingRequestCount() const {
+    return pendingRequests.size();
+}
+
+AllocationReport RegistrationSystem::closeAllocationWindow(const AllocationPolicy& policy) {
+    if (!allocationWindowOpen) {
+        throw RegistrationException("Allocation window is not open");
+    }
+    // Lazy mode: only the requesting students need to be resident
+    std::vector<uint32_t> pinned;
+    if (lazyStudents) {
+        for (const auto& request : pendingRequests) {
+            const Student* student = findStudentByID(request.studentID);
+            if (!student) continue;
+            uint32_t slot = studentIndex[student->getUsername()].index;
+            studentDirectory.pin(slot);
+            pinned.push_back(slot);
+        }
+    }
+    BatchAllocator allocator(courses, students, policy, &rules);
+    AllocationReport report = allocator.run(pendingRequests);
+    for (uint32_t slot : pinned) {
+        studentDirectory.markDirty(slot);
+        studentDirectory.unpin(slot);
+    }
+    pendingRequests.clear();
+    allocationWindowOpen = false;
+    markAllDirty();
+    catalogView.invalidate();
+    snapshots.publishAll(courses);
+    refreshSeatWatches();
+    for (const auto& outcome : report.outcomes) {
+        if (outcome.assignedCourse.empty()) continue;
+        logEvent(EnrollmentOp::SeatAllocated, outcome.assignedCourse, outcome.studentID, outcome.sectionID);
+    }
+    return report;
+}
+
+CohortReport RegistrationSystem::enrollCohort(const CohortSelector& selector,
+                                              const std::vector<std::string>& courseCodes,
+                                              const CohortPolicy& policy) {
+    CohortReport report;
+    std::vector<Course*> targets;
+    std::vector<CourseCode> codes;
+    for (const auto& code : courseCodes) {
+        Course& course = requireCourse(code);
+        if (std::find(targets.begin(), targets.end(), &course) != targets.end()) continue;
+        targets.push_back(&course);
+        codes.push_back(course.getCode());
+        report.courses.push_back(course.getCode().str());
+    }
+    if (targets.empty()) {
+        throw InvalidInputException("courses", "", "at least one course is required");
+    }
+
+    // ---- Select: listed IDs are looked up (and pinned in lazy mode), otherwise everyone is scanned ----
+    std::vector<Student*> cohort;
+    std::vector<uint32_t> pinned;
+    if (!selector.studentIDs.empty()) {
+        for (const auto& text : selector.studentIDs) {
+            StudentId id;
+            Student* student = StudentId::tryParse(text, id) ? findStudent(id) : nullptr;
+            if (!student) {
+                report.unknownIDs.push_back(text);
+                continue;
+            }
+            if (!selector.matches(*student)) continue;
+            if (lazyStudents) {
+                uint32_t slot = studentIDIndex.at(id).index;
+                studentDirectory.pin(slot);
+                pinned.push_back(slot);
+            }
+            cohort.push_back(student);
+        }
+        std::sort(cohort.begin(), cohort.end());
+        cohort.erase(std::unique(cohort.begin(), cohort.end()), cohort.end());
     } else {
-        std::string line;
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
-            std::stringstream ss(line);
-            std::string code, title, capacityStr, dayOfWeek, startTime, endTime, enrolledStr;
-            
-            std::getline(ss, code, '|');
-            std::getline(ss, title, '|');
-            std::getline(ss, capacityStr, '|');
-            std::getline(ss, dayOfWeek, '|');
-            std::getline(ss, startTime, '|');
-            std::getline(ss, endTime, '|');
-            std::getline(ss, enrolledStr, '|');
-
-            int capacity = std::stoi(capacityStr);
-            Course course(code, title, capacity, dayOfWeek, startTime, endTime);
-            auto enrolled = split(enrolledStr, ',');
-            for (const auto& id : enrolled) {
-                try {
-                    course.enrollStudent(id);
-                } catch (const std::exception&) {
-                    // ignore duplicates during load
+        pinAllStudents(pinned);
+        for (auto& student : students) {
+            if (selector.matches(student)) cohort.push_back(&student);
+        }
+    }
+    const size_t count = cohort.size();
+    const size_t courseCount = targets.size();
+    report.selected = count;
+
+    // ---- Eligibility; serial, the prerequisite check shares one scratch bitset ----
+    // outcome[s] stays Ok while the student is still a candidate
+    std::vector<RegistrationResult> outcome(count);
+    std::vector<CourseCode> taking;
+    for (size_t s = 0; s < count; ++s) {
+        const Student& student = *cohort[s];
+        // Corequisites may be met by the other courses of the batch
+        taking = student.getEnrolledCourses();
+        taking.insert(taking.end(), codes.begin(), codes.end());
+        for (size_t c = 0; c < courseCount; ++c) {
+            RegistrationResult& result = outcome[s];
+            if (targets[c]->isStudentEnrolled(student.getStudentID()) || student.isEnrolledIn(codes[c])) {
+                result.status = RegistrationStatus::AlreadyEnrolled;
+                result.studentID = student.getStudentID();
+            } else {
+                checkEligibility(student, codes[c], taking, result);
+            }
+            if (!result.ok()) {
+                result.courseCode = report.courses[c];
+                break;
+            }
+        }
+    }
+
+    // Every section of the batch gets a global index
+    std::vector<size_t> sectionBegin(courseCount + 1, 0);
+    std::vector<Section*> sections;
+    for (size_t c = 0; c < courseCount; ++c) {
+        for (const auto& section : targets[c]->getSections()) {
+            sections.push_back(targets[c]->findSection(section.getSectionID()));
+        }
+        sectionBegin[c + 1] = sections.size();
+    }
+    const size_t sectionCount = sections.size();
+
+    // ---- Time conflicts and rules, in parallel: which sections each student could take ----
+    // Only reads the catalog and the student records; seats are handed out below
+    std::vector<uint8_t> usable(count * sectionCount, 0);
+    unsigned chunks = policy.threads ? policy.threads : std::max(1u, std::thread::hardware_concurrency());
+    chunks = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(chunks, count)));
+    forEachShard(chunks, [&](size_t chunk) {
+        std::vector<std::pair<const Meeting*, CourseCode>> order;
+        std::vector<Meeting> schedule;
+        std::vector<CourseCode> owners;
+        RuleContext context;
+        for (size_t s = count * chunk / chunks; s < count * (chunk + 1) / chunks; ++s) {
+            if (!outcome[s].ok()) continue;
+            const Student& student = *cohort[s];
+
+            // Same as buildSchedule, with buffers local to this thread
+            order.clear();
+            for (const auto& enrolledCode : student.getEnrolledCourses()) {
+                const Course* enrolledCourse = getCourse(enrolledCode);
+                const Section* section = enrolledCourse ? enrolledCourse->findSectionOf(student.getStudentID()) : nullptr;
+                if (!section) continue;
+                for (const auto& meeting : section->getMeetings()) order.emplace_back(&meeting, enrolledCode);
+            }
+            std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+                return a.first->weekStart < b.first->weekStart;
+            });
+            schedule.clear();
+            owners.clear();
+            for (const auto& entry : order) {
+                schedule.push_back(*entry.first);
+                owners.push_back(entry.second);
+            }
+
+            // Rules see the load including the earlier courses of the batch
+            double batchCredits = 0.0;
+            for (size_t c = 0; c < courseCount; ++c) {
+                if (!rules.empty()) {
+                    fillRuleContext(student, codes[c], CourseCode(), context);
+                    context.credits += batchCredits;
+                    context.courses += static_cast<double>(c);
                 }
+                bool any = false;
+                int conflictIndex = -1;
+                int violatedRule = -1;
+                for (size_t g = sectionBegin[c]; g < sectionBegin[c + 1]; ++g) {
+                    if (!rules.empty()) {
+                        context.section = sections[g]->getSectionID();
+                        int violated = rules.firstViolation(context);
+                        if (violated >= 0) {
+                            if (violatedRule < 0) violatedRule = violated;
+                            continue;
+                        }
+                    }
+                    int overlap = Section::findOverlap(schedule, sections[g]->getMeetings());
+                    if (overlap < 0) {
+                        usable[s * sectionCount + g] = 1;
+                        any = true;
+                    } else if (conflictIndex < 0) {
+                        conflictIndex = overlap;
+                    }
+                }
+                if (!any) {
+                    RegistrationResult& result = outcome[s];
+                    result.courseCode = report.courses[c];
+                    if (conflictIndex >= 0) {
+                        result.status = RegistrationStatus::TimeConflict;
+                        result.conflictingCourse = owners[conflictIndex];
+                        result.conflictDay = schedule[conflictIndex].dayOfWeek;
+                    } else if (violatedRule >= 0) {
+                        setRuleViolation(violatedRule, result);
+                    } else {
+                        result.status = RegistrationStatus::CourseFull;
+                    }
+                    break;
+                }
+                if (!rules.empty()) batchCredits += rules.creditsOf(codes[c]);
+            }
+        }
+    });
+
+    // ---- Seats, in policy order; a student gets a section of every course or none ----
+    std::vector<size_t> order;
+    std::vector<double> priority(count, 0.0);
+    std::vector<uint64_t> lottery(count);
+    std::mt19937_64 rng(policy.seed);
+    for (size_t s = 0; s < count; ++s) {
+        lottery[s] = rng();
+        if (policy.priority == PriorityPolicy::GPA) {
+            priority[s] = cohort[s]->getGPA();
+        } else if (policy.priority == PriorityPolicy::ClassYear) {
+            // Earlier cohort first (lower student ID number), as in batch allocation
+            StudentId id = cohort[s]->getStudentID();
+            long number = 0;
+            for (char ch : id.view()) {
+                if (ch >= '0' && ch <= '9') number = number * 10 + (ch - '0');
             }
-            courses.push_back(course);
+            priority[s] = -static_cast<double>(number);
         }
+        if (outcome[s].ok()) order.push_back(s);
     }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (priority[a] != priority[b]) return priority[a] > priority[b];
+        return lottery[a] < lottery[b];
+    });
 
-    if (courses.empty()) {
-        courses.emplace_back("CS101", "Intro to Programming", 30, "Monday", "09:00", "10:30");
-        courses.emplace_back("MATH201", "Discrete Mathematics", 25, "Tuesday", "14:00", "15:30");
-        courses.emplace_back("ENG150", "Academic Writing", 40, "Wednesday", "10:00", "11:30");
+    std::vector<int> seatsLeft(sectionCount);
+    for (size_t g = 0; g < sectionCount; ++g) seatsLeft[g] = sections[g]->seatsRemaining();
+    std::vector<size_t> chosen(count * courseCount, SIZE_MAX);
+    bool shortOfSeats = false;
+    for (size_t s : order) {
+        size_t* picks = &chosen[s * courseCount];
+        for (size_t c = 0; c < courseCount; ++c) {
+            bool sawSeat = false;
+            int clashWith = -1;
+            int clashIndex = -1;
+            for (size_t g = sectionBegin[c]; g < sectionBegin[c + 1] && picks[c] == SIZE_MAX; ++g) {
+                if (!usable[s * sectionCount + g] || seatsLeft[g] <= 0) continue;
+                sawSeat = true;
+                // The batch's own courses must not overlap each other
+                int clash = -1;
+                for (size_t e = 0; e < c && clash < 0; ++e) {
+                    int overlap = Section::findOverlap(sections[picks[e]]->getMeetings(), sections[g]->getMeetings());
+                    if (overlap >= 0) {
+                        clash = static_cast<int>(e);
+                        if (clashWith < 0) {
+                            clashWith = clash;
+                            clashIndex = overlap;
+                        }
+                    }
+                }
+                if (clash < 0) picks[c] = g;
+            }
+            if (picks[c] != SIZE_MAX) continue;
+
+            RegistrationResult& result = outcome[s];
+            result.courseCode = report.courses[c];
+            if (!sawSeat) {
+                result.status = RegistrationStatus::CourseFull;
+                shortOfSeats = true;
+            } else {
+                result.status = RegistrationStatus::TimeConflict;
+                result.conflictingCourse = codes[clashWith];
+                result.conflictDay = sections[picks[clashWith]]->getMeetings()[clashIndex].dayOfWeek;
+            }
+            std::fill(picks, picks + courseCount, SIZE_MAX);
+            break;
+        }
+        if (picks[0] == SIZE_MAX) continue;
+        for (size_t c = 0; c < courseCount; ++c) --seatsLeft[picks[c]];
     }
-}
 
-void RegistrationSystem::loadStudents() {
-    std::ifstream file(studentsFilePath);
-    if (!file.is_open()) {
-        std::cout << "No student file found. Starting with an empty student list." << std::endl;
-        return;
+    for (size_t s = 0; s < count; ++s) {
+        if (!outcome[s].ok()) report.failures.push_back(CohortFailure{cohort[s]->getStudentID(), outcome[s]});
     }
+    std::sort(report.failures.begin(), report.failures.end(),
+              [](const CohortFailure& a, const CohortFailure& b) { return a.studentID.view() < b.studentID.view(); });
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-        std::stringstream ss(line);
-        std::string username, password, email, name, userID, studentID, major, gpaStr, coursesStr;
-        std::getline(ss, username, '|');
-        std::getline(ss, password, '|');
-        std::getline(ss, email, '|');
-        std::getline(ss, name, '|');
-        std::getline(ss, userID, '|');
-        std::getline(ss, studentID, '|');
-        std::getline(ss, major, '|');
-        std::getline(ss, gpaStr, '|');
-        std::getline(ss, coursesStr, '|');
+    if (shortOfSeats && policy.fill == CohortFill::AllOrNothing) {
+        report.applied = false;
+        releaseRoster(pinned);
+        return report;
+    }
 
-        double gpa = std::stod(gpaStr.empty() ? "0.0" : gpaStr);
-        Student student(username, password, email, name, userID, studentID, major, gpa);
-        student.setEnrolledCourses(split(coursesStr, ','));
-        students.push_back(student);
+    // ---- Apply: rosters and records, then indexes and views once for the batch ----
+    for (size_t s = 0; s < count; ++s) {
+        const size_t* picks = &chosen[s * courseCount];
+        if (!outcome[s].ok() || picks[0] == SIZE_MAX) continue;
+        Student& student = *cohort[s];
+        for (size_t c = 0; c < courseCount; ++c) {
+            sections[picks[c]]->enrollStudent(student.getStudentID(), codes[c]);
+            student.addCourse(codes[c]);
+            logEvent(EnrollmentOp::Registered, codes[c], student.getStudentID(), sections[picks[c]]->getSectionID());
+        }
+        markStudentDirty(student);
+        ++report.enrolled;
     }
+    std::vector<const Course*> changed(targets.begin(), targets.end());
+    for (const Course* course : changed) markCourseDirty(course->getCode().view());
+    catalogView.invalidate();
+    snapshots.publishCourses(changed);
+    for (const Course* course : changed) seatWatches.onSeatsChanged(*course);
+    releaseRoster(pinned);
+    return report;
 }
 
-void RegistrationSystem::saveCourses() const {
-    std::ofstream file(coursesFilePath, std::ios::trunc);
-    if (!file.is_open()) {
-        throw FileException(coursesFilePath, "write");
-    }
-    
-    for (const auto& course : courses) {
-        file << course.getCode() << '|'
-             << course.getTitle() << '|'
-             << course.getCapacity() << '|'
-             << course.getDayOfWeek() << '|'
-             << course.getStartTime() << '|'
-             << course.getEndTime() << '|';
-        const auto& enrolled = course.getEnrolledStudentIDs();
-        for (size_t i = 0; i < enrolled.size(); ++i) {
-            file << enrolled[i];
-            if (i + 1 < enrolled.size()) file << ',';
-        }
-        file << '\n';
+void RegistrationSystem::renderCatalogPage(CatalogStyle style, ListingCursor& cursor, size_t pageSize,
+                                           std::ostream& out) const {
+    // Each page reads the latest version; a course withdrawn between pages
+    // moves the last course into its position, like any live listing
+    CatalogReader catalog = readCatalog();
+    renderer.renderCatalogPage(*catalog, style, cursor, pageSize, out);
+}
+
+void RegistrationSystem::renderRosterPage(const std::string& code, ListingCursor& cursor, size_t pageSize,
+                                          std::ostream& out) const {
+    // Rendered from a pinned snapshot, so the roster cannot change mid-page
+    CatalogReader catalog = readCatalog();
+    const Course* course = catalog->find(code);
+    if (!course) {
+        throw RegistrationException("Course not found: " + code);
     }
+    renderer.renderRosterPage(*course, cursor, pageSize, out);
 }
 
-void RegistrationSystem::saveStudents() const {
-    std::ofstream file(studentsFilePath, std::ios::trunc);
-    if (!file.is_open()) {
-        throw FileException(studentsFilePath, "write");
+void RegistrationSystem::renderStudentsPage(ListingCursor& cursor, size_t pageSize, std::ostream& out) const {
+    if (!lazyStudents) {
+        renderer.renderStudentsPage(students, cursor, pageSize, out);
+        return;
     }
-    
+
+    // Lazy mode pages through the directory, then the residents not saved
+    // yet; only the records on this page are loaded, pinned while rendered
+    RegistrationSystem* self = const_cast<RegistrationSystem*>(this);
+    std::vector<const Student*> unsaved;
     for (const auto& student : students) {
-        file << student.getUsername() << '|'
-             << student.getPassword() << '|'
-             << student.getEmail() << '|'
-             << student.getName() << '|'
-             << student.getUserID() << '|'
-             << student.getStudentID() << '|'
-             << student.getMajor() << '|'
-             << student.getGPA() << '|';
-
-        const auto& enrolled = student.getEnrolledCourses();
-        for (size_t i = 0; i < enrolled.size(); ++i) {
-            file << enrolled[i];
-            if (i + 1 < enrolled.size()) file << ',';
+        if (studentDirectory.findUsername(student.getUsername()).empty()) unsaved.push_back(&student);
+    }
+    size_t indexed = studentDirectory.size();
+    size_t total = indexed + unsaved.size();
+    size_t end = pageSize == 0 ? total : std::min(total, static_cast<size_t>(cursor.slot) + pageSize);
+
+    std::vector<const Student*> page;
+    std::vector<uint32_t> pinned;
+    for (size_t i = cursor.slot; i < end; ++i) {
+        if (i >= indexed) {
+            page.push_back(unsaved[i - indexed]);
+            continue;
         }
-        file << '\n';
+        StudentRecord record;
+        if (!readStudentAt(studentDirectory.locationAt(i), record)) continue;
+        auto it = studentIndex.find(record.username);
+        const Student* student = it != studentIndex.end() ? students.get(it->second) : self->addResidentStudent(record);
+        uint32_t slot = studentIndex.at(student->getUsername()).index;
+        studentDirectory.pin(slot);
+        pinned.push_back(slot);
+        page.push_back(student);
+    }
+    cursor.slot = static_cast<uint32_t>(end);
+    renderer.renderStudentsPage(page, total, end == total, cursor, out);
+    self->releaseRoster(pinned);
+}
+
+AnalyticsReport RegistrationSystem::computeAnalytics(unsigned threads) const {
+    AllStudentsResident resident(*this);
+    return EnrollmentAnalytics::compute(courses, students, threads);
+}
+
+size_t RegistrationSystem::exportData(const ExportOptions& options, std::ostream& out) const {
+    ExportSnapshot snapshot;
+    {
+        AllStudentsResident resident(*this);
+        snapshot = DataExporter::snapshot(courses, students, options);
     }
-}
\ No newline at end of file
+    return DataExporter::write(snapshot, options.format, out);
+}
+
+size_t RegistrationSystem::startExport(const ExportOptions& options, const std::string& path) {
+    waitForExport();
+
+    ExportSnapshot snapshot;
+    {
+        AllStudentsResident resident(*this);
+        snapshot = DataExporter::snapshot(courses, students, options);
+    }
+    size_t rows = snapshot.rowCount();
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw FileException(path, "write");
+    }
+
+    exportPath = path;
+    exportFailed = false;
+    exportWorker = std::thread([this, snapshot = std::move(snapshot), file = std::move(file),
+                                format = options.format]() mutable {
+        DataExporter::write(snapshot, format, file);
+        file.close();
+        if (!file) exportFailed = true;
+    });
+    return rows;
+}
+
+void RegistrationSystem::waitForExport() {
+    if (!exportWorker.joinable()) return;
+    exportWorker.join();
+    if (exportFailed) {
+        exportFailed = false;
+        throw FileException(exportPath, "write");
+    }
+}
+
+// ---- Terms ----
+// terms.txt sits next to the course file: the active term ID on the first
+// line, then one archived term per line. Archives live in terms/<ID>.txt.
+
+std::string RegistrationSystem::termsFilePath() const {
+    return (std::filesystem::path(coursesFilePath).parent_path() / "terms.txt").string();
+}
+
+std::string RegistrationSystem::termArchivePath(const std::string& termID) const {
+    return (std::filesystem::path(coursesFilePath).parent_path() / "terms" / (termID + ".txt")).string();
+}
+
+void RegistrationSystem::loadTerms() {
+    activeTerm = "INITIAL";
+    archivedTerms.clear();
+    loadedTerms.clear();
+
+    std::ifstream file(termsFilePath());
+    if (!file.is_open()) return;
+    std::string line;
+    if (std::getline(file, line) && !line.empty()) activeTerm = line;
+    while (std::getline(file, line)) {
+        if (!line.empty()) archivedTerms.push_back(line);
+    }
+}
+
+void RegistrationSystem::saveTerms() const {
+    // Nothing to record until the first rollover
+    if (archivedTerms.empty() && activeTerm == "INITIAL") return;
+
+    std::ofstream file(termsFilePath(), std::ios::trunc);
+    if (!file.is_open()) {
+        throw FileException(termsFilePath(), "write");
+    }
+    file << activeTerm << '\n';
+    for (const auto& termID : archivedTerms) {
+        file << termID << '\n';
+    }
+}
+
+const std::string& RegistrationSystem::getActiveTerm() const {
+    return activeTerm;
+}
+
+const std::vector<std::string>& RegistrationSystem::getArchivedTerms() const {
+    return archivedTerms;
+}
+
+const TermArchive& RegistrationSystem::getArchivedTerm(const std::string& termID) const {
+    auto loaded = loadedTerms.find(termID);
+    if (loaded != loadedTerms.end()) return *loaded->second;
+
+    if (std::find(archivedTerms.begin(), archivedTerms.end(), termID) == archivedTerms.end()) {
+        throw RegistrationException("Term not found: " + termID);
+    }
+    std::unique_ptr<TermArchive> archive(new TermArchive(termID));
+    if (!readCourseFile(termArchivePath(termID), archive->courses)) {
+        throw FileException(termArchivePath(termID), "read");
+    }
+    archive->buildIndexes();
+    return *loadedTerms.emplace(termID, std::move(archive)).first->second;
+}
+
+void RegistrationSystem::rolloverTerm(const std::string& newTermID) {
+    if (allocationWindowOpen) {
+        throw RegistrationException("Close the allocation window before rolling over the term.");
+    }
+    if (newTermID == activeTerm ||
+        std::find(archivedTerms.begin(), archivedTerms.end(), newTermID) != archivedTerms.end()) {
+        throw DuplicateEntryException("term", newTermID);
+    }
+
+    AllStudentsResident resident(*this);
+
+    // Write the archive first so a failure leaves the active term untouched
+    std::filesystem::create_directories(std::filesystem::path(termArchivePath(activeTerm)).parent_path());
+    writeCourseFile(courses, termArchivePath(activeTerm));
+
+    for (auto& course : courses) {
+        course.clearRosters();
+    }
+    // The closing term's enrollments become completed-course history
+    for (auto& student : students) {
+        for (const auto& code : student.getEnrolledCourses()) student.addCompletedCourse(code);
+        student.setEnrolledCourses({});
+    }
+    archivedTerms.push_back(activeTerm);
+    activeTerm = newTermID;
+
+    catalogView.invalidate();
+    snapshots.publishAll(courses);
+    refreshSeatWatches();
+    logEvent(EnrollmentOp::TermRolledOver, CourseCode());
+    markAllDirty();
+    saveTerms();
+    saveCourses();
+    saveStudents();
+    eventLog.flush();
+}
+
+// ---- Prerequisites ----
+// prerequisites.txt sits next to the course file (see PrerequisiteGraph::save)
+
+std::string RegistrationSystem::prerequisitesFilePath() const {
+    return (std::filesystem::path(coursesFilePath).parent_path() / "prerequisites.txt").string();
+}
+
+bool RegistrationSystem::checkEligibility(const Student& student, CourseCode course,
+                                          const std::vector<CourseCode>& enrolled, RegistrationResult& result) {
+    CourseCode missing;
+    bool corequisite = false;
+    if (!prerequisites.findMissing(course, student.getCompletedCourses(), enrolled, missing, corequisite)) {
+        return true;
+    }
+    result.status = corequisite ? RegistrationStatus::MissingCorequisite : RegistrationStatus::MissingPrerequisite;
+    result.missingCourse = missing;
+    return false;
+}
+
+const PrerequisiteGraph& RegistrationSystem::getPrerequisites() const {
+    return prerequisites;
+}
+
+void RegistrationSystem::addPrerequisite(const std::string& code, const std::string& requiredCode) {
+    CourseCode course = requireCourse(code).getCode();
+    CourseCode required = requireCourse(requiredCode).getCode();
+    prerequisites.addPrerequisite(course, required);
+    prerequisitesDirty = true;
+}
+
+void RegistrationSystem::removePrerequisite(const std::string& code, const std::string& requiredCode) {
+    CourseCode course = requireCourse(code).getCode();
+    CourseCode required = requireCourse(requiredCode).getCode();
+    if (!prerequisites.removePrerequisite(course, required)) {
+        throw RegistrationException(code + " does not require " + requiredCode);
+    }
+    prerequisitesDirty = true;
+}
+
+void RegistrationSystem::addCorequisite(const std::string& code, const std::string& otherCode) {
+    CourseCode course = requireCourse(code).getCode();
+    CourseCode other = requireCourse(otherCode).getCode();
+    prerequisites.addCorequisite(course, other);
+    prerequisitesDirty = true;
+}
+
+void RegistrationSystem::removeCorequisite(const std::string& code, const std::string& otherCode) {
+    CourseCode course = requireCourse(code).getCode();
+    CourseCode other = requireCourse(otherCode).getCode();
+    if (!prerequisites.removeCorequisite(course, other)) {
+        throw RegistrationException(otherCode + " is not a corequisite of " + code);
+    }
+    prerequisitesDirty = true;
+}
+
+// ---- Registration rules ----
+
+std::string RegistrationSystem::rulesFilePath() const {
+    return (std::filesystem::path(coursesFilePath).parent_path() / "rules.txt").string();
+}
+
+void RegistrationSystem::fillRuleContext(const Student& student, CourseCode course, CourseCode dropping,
+                                         RuleContext& context) const {
+    context.gpa = student.getGPA();
+    context.credits = rules.creditsOf(course);
+    context.courses = 1;
+    for (const auto& code : student.getEnrolledCourses()) {
+        if (code == dropping) continue;
+        context.credits += rules.creditsOf(code);
+        context.courses += 1;
+    }
+    context.completedCredits = 0;
+    for (const auto& code : student.getCompletedCourses()) context.completedCredits += rules.creditsOf(code);
+    context.day = rules.registrationDay();
+    context.major = student.getMajor();
+    context.course = course;
+}
+
+void RegistrationSystem::setRuleViolation(int rule, RegistrationResult& result) const {
+    result.status = RegistrationStatus::RuleViolation;
+    result.ruleName = rules.ruleName(rule);
+    result.ruleText = rules.ruleText(rule);
+}
+
+void RegistrationSystem::reloadRules() {
+    rules = RuleSet::load(rulesFilePath());
+}
+
+const RuleSet& RegistrationSystem::getRules() const {
+    return rules;
+}
+
+// ---- Enrollment log ----
+
+std::string RegistrationSystem::enrollmentLogPath() const {
+    return (std::filesystem::path(coursesFilePath).parent_path() / "enrollment-log").string();
+}
+
+RegistrationSystem::ActorScope::ActorScope(RegistrationSystem& system, std::string_view userID)
+    : system(system), previous(system.actor) {
+    // Throws before anything is logged rather than recording an unattributed change
+    system.actor = userID.empty() ? UserId() : UserId(userID);
+}
+
+RegistrationSystem::ActorScope::~ActorScope() {
+    system.actor = previous;
+}
+
+void RegistrationSystem::logEvent(EnrollmentOp op, CourseCode course, StudentId student, std::string_view sectionID) {
+    EnrollmentEvent event;
+    event.op = op;
+    event.course = course;
+    event.student = student;
+    event.setSection(sectionID);
+    event.actor = actor;
+    if (actor.empty() && !student.empty()) UserId::tryParse(student.view(), event.actor);
+    eventLog.append(event);
+}
+
+const EnrollmentLog& RegistrationSystem::getEnrollmentLog() const {
+    return eventLog;
+}
+
+std::vector<StudentId> RegistrationSystem::seatHoldersAt(const std::string& courseCode, int64_t time) const {
+    CourseCode key;
+    if (!CourseCode::tryParse(courseCode, key)) {
+        throw RegistrationException("Course not found: " + courseCode);
+    }
+    // Changes to the course after time, up to the first rollover after it
+    std::vector<EnrollmentEvent> later;
+    size_t rollovers = 0;
+    eventLog.scan(time + 1, INT64_MAX, [&](const EnrollmentEvent& event) {
+        if (event.op == EnrollmentOp::TermRolledOver) ++rollovers;
+        else if (rollovers == 0 && event.course == key) later.push_back(event);
+    });
+
+    // Start from the roster as that term ended (or as it is now) and undo
+    const Course* course = nullptr;
+    if (rollovers == 0) {
+        course = getCourse(courseCode);
+    } else if (rollovers <= archivedTerms.size()) {
+        course = getArchivedTerm(archivedTerms[archivedTerms.size() - rollovers]).getCourse(courseCode);
+    }
+    std::vector<StudentId> holders;
+    if (course) {
+        for (const auto& section : course->getSections()) {
+            const auto& ids = section.getEnrolledStudentIDs();
+            holders.insert(holders.end(), ids.begin(), ids.end());
+        }
+    }
+    for (auto it = later.rbegin(); it != later.rend(); ++it) {
+        auto held = std::find(holders.begin(), holders.end(), it->student);
+        if (it->grantsSeat() && held != holders.end()) {
+            holders.erase(held);
+        } else if (it->releasesSeat() && held == holders.end()) {
+            holders.push_back(it->student);
+        }
+    }
+    std::sort(holders.begin(), holders.end());
+    return holders;
+}
+
+SeatSubscriptions::Id RegistrationSystem::watchSeats(const std::string& courseCode,
+                                                    SeatSubscriptions::Callback callback) {
+    return seatWatches.subscribe(requireCourse(courseCode), std::move(callback));
+}
+
+SeatSubscriptions::Id RegistrationSystem::watchSeats(const SeatFilter& filter, SeatSubscriptions::Callback callback) {
+    return seatWatches.subscribe(filter, courses, std::move(callback));
+}
+
+void RegistrationSystem::unwatchSeats(SeatSubscriptions::Id id) {
+    seatWatches.unsubscribe(id);
+}
+
+void RegistrationSystem::refreshSeatWatches() {
+    if (seatWatches.empty()) return;
+    for (CourseCode code : seatWatches.watchedCourses()) {
+        Course* course = findCourse(code.view());
+        if (course) seatWatches.onSeatsChanged(*course);
+        else seatWatches.onCourseRemoved(code);
+    }
+}
+
+CatalogReader RegistrationSystem::readCatalog() const {
+    return snapshots.read();
+}
+
+const CatalogView& RegistrationSystem::getCatalogView() const {
+    catalogView.refresh(courses);
+    return catalogView;
+}
+
+void RegistrationSystem::searchSections(const CatalogQuery& query, std::ostream& out) const {
+    const CatalogView& view = getCatalogView();
+    std::vector<uint32_t> rows = view.filter(query);
+
+    out << "\n=====================================\n";
+    out << "      MATCHING SECTIONS              \n";
+    out << "=====================================\n";
+    for (uint32_t row : rows) {
+        out << view.getCode(row) << " " << view.getSectionID(row) << " - " << view.getTitle(row);
+        if (view.getDay(row) >= 0) {
+            out << " | " << Section::dayName(view.getDay(row)) << " "
+                << Section::minutesToTime(view.getStart(row)) << "-"
+                << Section::minutesToTime(view.getEnd(row));
+        }
+        out << " | Seats: " << (view.getCapacity(row) - view.getEnrolled(row))
+            << "/" << view.getCapacity(row) << '\n';
+    }
+    out << "-------------------------------------\n";
+    out << rows.size() << " matching meeting(s)\n";
+}
+
+std::vector<std::string> RegistrationSystem::split(const std::string& input, char delimiter) {
+    std::vector<std::string> tokens;
+    std::stringstream ss(input);
+    std::string item;
+    while (std::getline(ss, item, delimiter)) {
+        if (!item.empty()) {
+            tokens.push_back(item);
+        }
+    }
+    return tokens;
+}
+
+// Course line formats:
+//   legacy:  code|title|capacity|day|start|end|id1,id2
+//   current: code|title|sectionID;capacity;Day HH:MM-HH:MM,...;id1,id2|sectionID;...
+Course RegistrationSystem::parseCourseLine(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, '|')) {
+        fields.push_back(field);
+    }
+    while (fields.size() < 3) fields.emplace_back();
+
+    // Legacy lines carry a capacity here; an empty field is a course saved
+    // without sections
+    bool legacy = !fields[2].empty() && fields[2].find(';') == std::string::npos;
+    if (legacy) {
+        while (fields.size() < 7) fields.emplace_back();
+        Course course(fields[0], fields[1], std::stoi(fields[2]), fields[3], fields[4], fields[5]);
+        for (const auto& id : split(fields[6], ',')) {
+            try {
+                course.enrollStudent(id);
+            } catch (const std::exception&) {
+                // ignore duplicates during load
+            }
+        }
+        return course;
+    }
+
+    Course course(fields[0], fields[1]);
+    for (size_t i = 2; i < fields.size(); ++i) {
+        if (fields[i].empty()) continue;
+        std::vector<std::string> parts;
+        std::stringstream sectionStream(fields[i]);
+        std::string part;
+        while (std::getline(sectionStream, part, ';')) {
+            parts.push_back(part);
+        }
+        while (parts.size() < 4) parts.emplace_back();
+
+        Section section(parts[0], std::stoi(parts[1]), Section::parseMeetings(parts[2]));
+        for (const auto& id : split(parts[3], ',')) {
+            try {
+                section.enrollStudent(id, course.getCode());
+            } catch (const std::exception&) {
+                // ignore duplicates during load
+            }
+        }
+        course.addSection(section);
+    }
+    return course;
+}
+
+bool RegistrationSystem::readCourseFile(const std::string& path, CourseStore& store) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        store.emplace(parseCourseLine(line));
+    }
+    return true;
+}
+
+// ---- Sharded storage ----
+// shards.txt next to the course file holds the shard count; without it the
+// single-file layout (courses.txt / students.txt) is used.
+
+bool RegistrationSystem::parseStudentLine(const std::string& line, StudentRecord& record) {
+    // Splits on '|' in place; a missing trailing field reads as empty
+    size_t pos = 0;
+    auto next = [&line, &pos](std::string& field) {
+        size_t end = std::min(line.find('|', pos), line.size());
+        field.assign(line, std::min(pos, line.size()), end - std::min(pos, end));
+        pos = end + 1;
+    };
+    std::string idStr, gpaStr, coursesStr, completedStr;
+    next(record.username);
+    next(record.password);
+    next(record.email);
+    next(record.name);
+    next(record.userID);
+    next(idStr);
+    next(record.major);
+    next(gpaStr);
+    next(coursesStr);
+    next(completedStr);
+    if (!StudentId::tryParse(idStr, record.studentID)) return false;
+    record.gpa = std::stod(gpaStr.empty() ? "0.0" : gpaStr);
+    record.courses.clear();
+    for (const auto& code : split(coursesStr, ',')) {
+        CourseCode key;
+        if (CourseCode::tryParse(code, key)) record.courses.push_back(key);
+    }
+    record.completed.clear();
+    for (const auto& code : split(completedStr, ',')) {
+        CourseCode key;
+        if (CourseCode::tryParse(code, key)) record.completed.push_back(key);
+    }
+    return true;
+}
+
+Student* RegistrationSystem::addResidentStudent(StudentRecord& record) {
+    SlabHandle handle = students.emplace(std::move(record.username), std::move(record.password),
+                                         std::move(record.email), std::move(record.name),
+                                         std::move(record.userID), record.studentID,
+                                         std::move(record.major), record.gpa);
+    Student* student = students.get(handle);
+    student->setEnrolledCourses(std::move(record.courses));
+    student->setCompletedCourses(std::move(record.completed));
+    studentIndex[student->getUsername()] = handle;
+    studentIDIndex[student->getStudentID()] = handle;
+    if (lazyStudents) {
+        studentDirectory.touch(handle.index);
+        evictStudents(handle.index);
+    }
+    return student;
+}
+
+std::string RegistrationSystem::shardsFilePath() const {
+    return (std::filesystem::path(coursesFilePath).parent_path() / "shards.txt").string();
+}
+
+void RegistrationSystem::loadShardCount() {
+    size_t count = 1;
+    std::ifstream file(shardsFilePath());
+    if (file.is_open()) {
+        file >> count;
+        if (!file || count == 0) count = 1;
+    }
+    courseShards = ShardLayout(coursesFilePath, count);
+    studentShards = ShardLayout(studentsFilePath, count);
+    dirtyCourseShards.assign(count, 0);
+    dirtyStudentShards.assign(count, 0);
+}
+
+size_t RegistrationSystem::getShardCount() const {
+    return courseShards.count();
+}
+
+void RegistrationSystem::markCourseDirty(std::string_view code) {
+    dirtyCourseShards[courseShards.shardOf(code)] = 1;
+}
+
+void RegistrationSystem::markStudentDirty(const Student& student) {
+    dirtyStudentShards[studentShards.shardOf(student.getUsername())] = 1;
+    if (lazyStudents) {
+        auto it = studentIndex.find(student.getUsername());
+        if (it != studentIndex.end()) studentDirectory.markDirty(it->second.index);
+    }
+}
+
+void RegistrationSystem::markAllDirty() {
+    std::fill(dirtyCourseShards.begin(), dirtyCourseShards.end(), 1);
+    std::fill(dirtyStudentShards.begin(), dirtyStudentShards.end(), 1);
+}
+
+void RegistrationSystem::loadCourses() {
+    // Shards are parsed in parallel, then moved into the store on this thread
+    std::vector<std::vector<Course>> parsed(courseShards.count());
+    std::vector<char> found(courseShards.count(), 0);
+    forEachShard(courseShards.count(), [&](size_t shard) {
+        std::ifstream file(courseShards.path(shard));
+        if (!file.is_open()) return;
+        found[shard] = 1;
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty()) continue;
+            parsed[shard].push_back(parseCourseLine(line));
+        }
+    });
+    if (std::find(found.begin(), found.end(), 1) == found.end()) {
+        std::cout << "No course file found. Starting with sample courses." << std::endl;
+    }
+    for (auto& shard : parsed) {
+        for (auto& course : shard) courses.emplace(std::move(course));
+    }
+
+    if (courses.empty()) {
+        courses.emplace("CS101", "Intro to Programming", 30, "Monday", "09:00", "10:30");
+        courses.emplace("MATH201", "Discrete Mathematics", 25, "Tuesday", "14:00", "15:30");
+        courses.emplace("ENG150", "Academic Writing", 40, "Wednesday", "10:00", "11:30");
+        std::fill(dirtyCourseShards.begin(), dirtyCourseShards.end(), 1);
+    }
+    rebuildCourseIndex();
+    catalogView.invalidate();
+    snapshots.publishAll(courses);
+    refreshSeatWatches();
+}
+
+void RegistrationSystem::loadStudents() {
+    auto reportSkipped = [](size_t invalid) {
+        if (invalid > 0) {
+            std::cout << "Skipped " << invalid << " student record(s) with an invalid student ID." << std::endl;
+        }
+    };
+    if (lazyStudents) {
+        studentDirectory.clear();
+        reportSkipped(studentDirectory.build(studentShards));
+        return;
+    }
+
+    std::vector<std::vector<StudentRecord>> parsed(studentShards.count());
+    std::vector<char> found(studentShards.count(), 0);
+    std::vector<size_t> skipped(studentShards.count(), 0);
+    forEachShard(studentShards.count(), [&](size_t shard) {
+        std::ifstream file(studentShards.path(shard));
+        if (!file.is_open()) return;
+        found[shard] = 1;
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty()) continue;
+            StudentRecord record;
+            if (!parseStudentLine(line, record)) {
+                ++skipped[shard];
+                continue;
+            }
+            parsed[shard].push_back(std::move(record));
+        }
+    });
+    if (std::find(found.begin(), found.end(), 1) == found.end()) {
+        std::cout << "No student file found. Starting with an empty student list." << std::endl;
+        return;
+    }
+    size_t invalid = 0;
+    for (size_t count : skipped) invalid += count;
+    reportSkipped(invalid);
+
+    size_t total = 0;
+    for (const auto& shard : parsed) total += shard.size();
+    studentIndex.reserve(total);
+    studentIDIndex.reserve(total);
+    for (auto& shard : parsed) {
+        for (auto& record : shard) {
+            // Records already resident (loaded lazily) are newer than the file
+            if (studentIndex.count(record.username)) continue;
+            addResidentStudent(record);
+        }
+    }
+}
+
+// ---- Lazy students ----
+
+void RegistrationSystem::enableLazyStudents(size_t cacheCapacity) {
+    lazyStudents = true;
+    studentCacheCapacity = cacheCapacity == 0 ? 1 : cacheCapacity;
+}
+
+size_t RegistrationSystem::getStudentCount() const {
+    if (!lazyStudents) return students.size();
+    // Indexed records plus resident ones not saved yet
+    size_t unsaved = 0;
+    for (const auto& student : students) {
+        if (studentDirectory.findUsername(student.getUsername()).empty()) ++unsaved;
+    }
+    return studentDirectory.size() + unsaved;
+}
+
+bool RegistrationSystem::readStudentAt(const StudentLocation& location, StudentRecord& record) const {
+    std::string line;
+    if (!StudentDirectory::readLine(studentShards, location, line) || line.empty()) return false;
+    return parseStudentLine(line, record);
+}
+
+const Student* RegistrationSystem::findStudentByID(const std::string& studentID) {
+    StudentId key;
+    return StudentId::tryParse(studentID, key) ? findStudent(key) : nullptr;
+}
+
+Student* RegistrationSystem::findStudent(StudentId studentID) {
+    auto it = studentIDIndex.find(studentID);
+    if (it != studentIDIndex.end()) {
+        if (lazyStudents) studentDirectory.touch(it->second.index);
+        return students.get(it->second);
+    }
+    if (!lazyStudents) return nullptr;
+
+    for (const auto& location : studentDirectory.findStudentID(studentID.str())) {
+        StudentRecord record;
+        if (readStudentAt(location, record) && record.studentID == studentID &&
+            studentIndex.count(record.username) == 0) {
+            return addResidentStudent(record);
+        }
+    }
+    return nullptr;
+}
+
+void RegistrationSystem::evictStudents(uint32_t keepSlot) {
+    while (students.size() > studentCacheCapacity) {
+        uint32_t slot;
+        if (!studentDirectory.evictionCandidate(slot) || slot == keepSlot) break;
+        auto it = students.from(slot);
+        if (it == students.end() || it.slotIndex() != slot) {
+            studentDirectory.forget(slot);
+            continue;
+        }
+        SlabHandle handle = it.handle();
+        studentIndex.erase(it->getUsername());
+        studentIDIndex.erase(it->getStudentID());
+        studentDirectory.forget(slot);
+        students.erase(handle);
+    }
+}
+
+void RegistrationSystem::pinAllStudents(std::vector<uint32_t>& pinned) {
+    if (!lazyStudents) return;
+    // Residents first, so loading the rest cannot evict them
+    for (auto it = students.begin(); it != students.end(); ++it) {
+        studentDirectory.pin(it.slotIndex());
+        pinned.push_back(it.slotIndex());
+    }
+    for (size_t shard = 0; shard < studentShards.count(); ++shard) {
+        std::ifstream file(studentShards.path(shard));
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty()) continue;
+            StudentRecord record;
+            if (!parseStudentLine(line, record) || studentIndex.count(record.username)) continue;
+            Student* student = addResidentStudent(record);
+            uint32_t slot = studentIndex.at(student->getUsername()).index;
+            studentDirectory.pin(slot);
+            pinned.push_back(slot);
+        }
+    }
+}
+
+RegistrationSystem::AllStudentsResident::AllStudentsResident(const RegistrationSystem& system)
+    : system(const_cast<RegistrationSystem&>(system)) {
+    this->system.pinAllStudents(pinned);
+}
+
+RegistrationSystem::AllStudentsResident::~AllStudentsResident() {
+    system.releaseRoster(pinned);
+}
+
+// Lazy-mode save: each dirty shard is rewritten by copying the lines of
+// records that are not resident and writing resident records from memory
+void RegistrationSystem::saveStudentShardsMerged() const {
+    const size_t count = studentShards.count();
+    std::vector<std::vector<StudentDirectory::LineInfo>> lines(count);
+    std::vector<std::vector<const Student*>> residents(count);
+    for (const auto& student : students) {
+        size_t shard = studentShards.shardOf(student.getUsername());
+        if (dirtyStudentShards[shard]) residents[shard].push_back(&student);
+    }
+
+    forEachShard(count, [&](size_t shard) {
+        if (!dirtyStudentShards[shard]) return;
+        std::string path = studentShards.path(shard);
+        std::string tmpPath = path + ".tmp";
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw FileException(tmpPath, "write");
+        }
+
+        std::unordered_map<std::string, const Student*> pending;
+        for (const Student* student : residents[shard]) pending.emplace(student->getUsername(), student);
+
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        while (in.is_open() && std::getline(in, line)) {
+            if (line.empty()) continue;
+            uint64_t offset = static_cast<uint64_t>(out.tellp());
+            StudentDirectory::LineInfo keys = StudentDirectory::lineKeys(line, offset);
+            auto it = pending.find(keys.username);
+            if (it == pending.end()) {
+                out << line << '\n';
+            } else {
+                writeStudentLine(out, *it->second);
+                pending.erase(it);
+            }
+            lines[shard].push_back(std::move(keys));
+        }
+        in.close();
+        // Residents not in the file yet (new sign-ups)
+        for (const Student* student : residents[shard]) {
+            if (pending.count(student->getUsername()) == 0) continue;
+            uint64_t offset = static_cast<uint64_t>(out.tellp());
+            writeStudentLine(out, *student);
+            lines[shard].push_back(
+                StudentDirectory::LineInfo{student->getUsername(), student->getStudentID().str(), offset});
+        }
+        out.close();
+        if (!out) {
+            throw FileException(tmpPath, "write");
+        }
+        std::filesystem::rename(tmpPath, path);
+    });
+
+    for (size_t shard = 0; shard < count; ++shard) {
+        if (!dirtyStudentShards[shard]) continue;
+        studentDirectory.replaceShard(static_cast<uint32_t>(shard), lines[shard]);
+        for (const Student* student : residents[shard]) {
+            studentDirectory.clearDirty(studentIndex.at(student->getUsername()).index);
+        }
+    }
+}
+
+void RegistrationSystem::writeCourseLine(std::ostream& out, const Course& course) {
+    out << course.getCode() << '|'
+        << course.getTitle();
+    for (const auto& section : course.getSections()) {
+        out << '|' << section.getSectionID() << ';'
+            << section.getCapacity() << ';'
+            << section.scheduleString() << ';';
+        const auto& enrolled = section.getEnrolledStudentIDs();
+        for (size_t i = 0; i < enrolled.size(); ++i) {
+            out << enrolled[i];
+            if (i + 1 < enrolled.size()) out << ',';
+        }
+    }
+    out << '\n';
+}
+
+void RegistrationSystem::writeStudentLine(std::ostream& out, const Student& student) {
+    out << student.getUsername() << '|'
+        << student.getPassword() << '|'
+        << student.getEmail() << '|'
+        << student.getName() << '|'
+        << student.getUserID() << '|'
+        << student.getStudentID() << '|'
+        << student.getMajor() << '|'
+        << student.getGPA() << '|';
+
+    const auto& enrolled = student.getEnrolledCourses();
+    for (size_t i = 0; i < enrolled.size(); ++i) {
+        out << enrolled[i];
+        if (i + 1 < enrolled.size()) out << ',';
+    }
+    // Completed history is an optional tenth field, omitted when empty
+    const auto& completed = student.getCompletedCourses();
+    for (size_t i = 0; i < completed.size(); ++i) {
+        out << (i == 0 ? '|' : ',') << completed[i];
+    }
+    out << '\n';
+}
+
+void RegistrationSystem::writeCourseFile(const CourseStore& store, const std::string& path) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        throw FileException(path, "write");
+    }
+    for (const auto& course : store) {
+        writeCourseLine(file, course);
+    }
+}
+
+// Records are bucketed by shard in one pass, then each selected shard is
+// written by its own thread. 'suffix' lets reshard write to temporary files.
+template <typename Store, typename KeyOf, typename WriteLine>
+static void writeShards(const Store& store, const ShardLayout& layout, const std::vector<char>& selected,
+                        const std::string& suffix, KeyOf keyOf, WriteLine writeLine) {
+    typedef typename std::remove_reference<decltype(*store.begin())>::type Record;
+    std::vector<std::vector<const Record*>> buckets(layout.count());
+    for (const auto& record : store) {
+        size_t shard = layout.shardOf(keyOf(record));
+        if (selected[shard]) buckets[shard].push_back(&record);
+    }
+    forEachShard(layout.count(), [&](size_t shard) {
+        if (!selected[shard]) return;
+        std::string path = layout.path(shard) + suffix;
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            throw FileException(path, "write");
+        }
+        for (const Record* record : buckets[shard]) {
+            writeLine(file, *record);
+        }
+    });
+}
+
+void RegistrationSystem::saveCourses() const {
+    if (std::find(dirtyCourseShards.begin(), dirtyCourseShards.end(), 1) == dirtyCourseShards.end()) return;
+    writeShards(courses, courseShards, dirtyCourseShards, "",
+                [](const Course& course) { return course.getCode(); }, writeCourseLine);
+    std::fill(dirtyCourseShards.begin(), dirtyCourseShards.end(), 0);
+}
+
+void RegistrationSystem::saveStudents() const {
+    if (std::find(dirtyStudentShards.begin(), dirtyStudentShards.end(), 1) == dirtyStudentShards.end()) return;
+    if (lazyStudents) {
+        saveStudentShardsMerged();
+        std::fill(dirtyStudentShards.begin(), dirtyStudentShards.end(), 0);
+        return;
+    }
+    writeShards(students, studentShards, dirtyStudentShards, "",
+                [](const Student& student) -> std::string_view { return student.getUsername(); },
+                writeStudentLine);
+    std::fill(dirtyStudentShards.begin(), dirtyStudentShards.end(), 0);
+}
+
+void RegistrationSystem::reshard(size_t newCount) {
+    if (newCount == 0) {
+        throw InvalidInputException("shard count", "0", "must be at least 1");
+    }
+    AllStudentsResident resident(*this);
+    ShardLayout newCourseShards(coursesFilePath, newCount);
+    ShardLayout newStudentShards(studentsFilePath, newCount);
+    std::vector<char> all(newCount, 1);
+
+    // Write the whole new layout to .tmp files before touching the old one
+    writeShards(courses, newCourseShards, all, ".tmp",
+                [](const Course& course) { return course.getCode(); }, writeCourseLine);
+    writeShards(students, newStudentShards, all, ".tmp",
+                [](const Student& student) -> std::string_view { return student.getUsername(); },
+                writeStudentLine);
+
+    std::vector<std::string> oldFiles;
+    for (size_t shard = 0; shard < courseShards.count(); ++shard) {
+        oldFiles.push_back(courseShards.path(shard));
+        oldFiles.push_back(studentShards.path(shard));
+    }
+    std::vector<std::string> newFiles;
+    for (size_t shard = 0; shard < newCount; ++shard) {
+        newFiles.push_back(newCourseShards.path(shard));
+        newFiles.push_back(newStudentShards.path(shard));
+    }
+    for (const auto& path : newFiles) {
+        std::filesystem::rename(path + ".tmp", path);
+    }
+
+    std::ofstream file(shardsFilePath(), std::ios::trunc);
+    if (!file.is_open()) {
+        throw FileException(shardsFilePath(), "write");
+    }
+    file << newCount << '\n';
+    file.close();
+
+    for (const auto& path : oldFiles) {
+        if (std::find(newFiles.begin(), newFiles.end(), path) == newFiles.end()) {
+            std::filesystem::remove(path);
+        }
+    }
+
+    courseShards = newCourseShards;
+    studentShards = newStudentShards;
+    dirtyCourseShards.assign(newCount, 0);
+    dirtyStudentShards.assign(newCount, 0);
+    if (lazyStudents) {
+        // Every record was resident and is now written to the new layout
+        for (auto it = students.begin(); it != students.end(); ++it) studentDirectory.clearDirty(it.slotIndex());
+        studentDirectory.build(studentShards);
+    }
+}
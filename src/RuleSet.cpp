@@ -0,0 +1,229 @@
+#include "../include/RuleSet.h"
+#include "../include/CustomExceptions.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+struct FieldName {
+    const char* name;
+    RuleField field;
+    bool numeric;
+};
+
+const FieldName FIELDS[] = {
+    {"gpa", RuleField::Gpa, true},
+    {"credits", RuleField::Credits, true},
+    {"courses", RuleField::Courses, true},
+    {"completed_credits", RuleField::CompletedCredits, true},
+    {"day", RuleField::Day, true},
+    {"major", RuleField::Major, false},
+    {"course", RuleField::Course, false},
+    {"section", RuleField::Section, false},
+};
+
+struct OpName {
+    const char* name;
+    RuleOp op;
+};
+
+const OpName OPS[] = {
+    {"<", RuleOp::Less}, {"<=", RuleOp::LessEqual}, {">", RuleOp::Greater}, {">=", RuleOp::GreaterEqual},
+    {"==", RuleOp::Equal}, {"!=", RuleOp::NotEqual}, {"^=", RuleOp::Prefix},
+};
+
+bool parseNumber(const std::string& text, double& value) {
+    try {
+        size_t used = 0;
+        value = std::stod(text, &used);
+        return used == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool compareNumber(double value, RuleOp op, double operand) {
+    switch (op) {
+        case RuleOp::Less: return value < operand;
+        case RuleOp::LessEqual: return value <= operand;
+        case RuleOp::Greater: return value > operand;
+        case RuleOp::GreaterEqual: return value >= operand;
+        case RuleOp::Equal: return value == operand;
+        case RuleOp::NotEqual: return value != operand;
+        case RuleOp::Prefix: return false;
+    }
+    return false;
+}
+
+bool compareText(std::string_view value, RuleOp op, std::string_view operand) {
+    switch (op) {
+        case RuleOp::Equal: return value == operand;
+        case RuleOp::NotEqual: return value != operand;
+        case RuleOp::Prefix: return value.substr(0, operand.size()) == operand;
+        default: return false;
+    }
+}
+
+} // namespace
+
+bool RuleSet::test(const Instruction& instruction, const RuleContext& context) const {
+    switch (instruction.field) {
+        case RuleField::Gpa: return compareNumber(context.gpa, instruction.op, instruction.number);
+        case RuleField::Credits: return compareNumber(context.credits, instruction.op, instruction.number);
+        case RuleField::Courses: return compareNumber(context.courses, instruction.op, instruction.number);
+        case RuleField::CompletedCredits:
+            return compareNumber(context.completedCredits, instruction.op, instruction.number);
+        case RuleField::Day: return compareNumber(context.day, instruction.op, instruction.number);
+        case RuleField::Major: return compareText(context.major, instruction.op, texts[instruction.text]);
+        case RuleField::Course: return compareText(context.course.view(), instruction.op, texts[instruction.text]);
+        case RuleField::Section: return compareText(context.section, instruction.op, texts[instruction.text]);
+    }
+    return false;
+}
+
+int RuleSet::firstViolation(const RuleContext& context) const {
+    for (size_t r = 0; r < rules.size(); ++r) {
+        const Rule& rule = rules[r];
+        uint32_t i = rule.whenBegin;
+        while (i < rule.requireBegin && test(program[i], context)) ++i;
+        if (i < rule.requireBegin) continue;   // Does not apply to this attempt
+        while (i < rule.end && test(program[i], context)) ++i;
+        if (i < rule.end) return static_cast<int>(r);
+    }
+    return -1;
+}
+
+double RuleSet::creditsOf(CourseCode code) const {
+    auto it = courseCredits.find(code);
+    return it == courseCredits.end() ? defaultCredits : it->second;
+}
+
+double RuleSet::registrationDay() const {
+    if (!hasOpens) return std::numeric_limits<double>::max();
+    auto today = std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now());
+    return static_cast<double>(today.time_since_epoch().count() - opensDay + 1);
+}
+
+// field op value, appended to the program
+void RuleSet::compileCondition(const std::vector<std::string>& tokens, size_t& pos, const std::string& where) {
+    if (pos + 3 > tokens.size()) {
+        throw InvalidInputException("rule", "", where + ": expected 'field op value'");
+    }
+    const std::string& fieldName = tokens[pos];
+    const std::string& opName = tokens[pos + 1];
+    const std::string& value = tokens[pos + 2];
+    pos += 3;
+
+    const FieldName* field = nullptr;
+    for (const auto& candidate : FIELDS) {
+        if (fieldName == candidate.name) field = &candidate;
+    }
+    if (!field) {
+        throw InvalidInputException("rule", fieldName, where + ": unknown field '" + fieldName + "'");
+    }
+    const OpName* op = nullptr;
+    for (const auto& candidate : OPS) {
+        if (opName == candidate.name) op = &candidate;
+    }
+    if (!op || (field->numeric && op->op == RuleOp::Prefix) ||
+        (!field->numeric && op->op != RuleOp::Equal && op->op != RuleOp::NotEqual && op->op != RuleOp::Prefix)) {
+        throw InvalidInputException("rule", opName, where + ": operator '" + opName + "' cannot be used with " +
+                                    fieldName);
+    }
+
+    Instruction instruction{field->field, op->op, 0, 0.0};
+    if (field->numeric) {
+        if (!parseNumber(value, instruction.number)) {
+            throw InvalidInputException("rule", value, where + ": '" + value + "' is not a number");
+        }
+    } else {
+        instruction.text = static_cast<uint32_t>(texts.size());
+        texts.push_back(value);
+    }
+    program.push_back(instruction);
+}
+
+RuleSet RuleSet::compile(std::istream& in, const std::string& sourceName) {
+    RuleSet set;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        std::string where = sourceName + " line " + std::to_string(lineNumber);
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        std::vector<std::string> tokens;
+        std::stringstream ss(line);
+        std::string token;
+        while (ss >> token) tokens.push_back(token);
+        if (tokens.empty()) continue;
+
+        if (tokens[0] == "opens") {
+            int y = 0;
+            unsigned m = 0, d = 0;
+            std::chrono::year_month_day date;
+            if (tokens.size() != 2 || std::sscanf(tokens[1].c_str(), "%d-%u-%u", &y, &m, &d) != 3 ||
+                !(date = std::chrono::year(y) / std::chrono::month(m) / std::chrono::day(d)).ok()) {
+                throw InvalidInputException("rule", line, where + ": expected 'opens YYYY-MM-DD'");
+            }
+            set.hasOpens = true;
+            set.opensDay = std::chrono::sys_days(date).time_since_epoch().count();
+
+        } else if (tokens[0] == "credits") {
+            double credits = 0.0;
+            CourseCode code;
+            if (tokens.size() != 3 || !parseNumber(tokens[2], credits) || credits < 0 ||
+                (tokens[1] != "default" && !CourseCode::tryParse(tokens[1], code))) {
+                throw InvalidInputException("rule", line, where + ": expected 'credits default|CODE hours'");
+            }
+            if (tokens[1] == "default") set.defaultCredits = credits;
+            else set.courseCredits[code] = credits;
+
+        } else if (tokens[0] == "rule") {
+            if (tokens.size() < 2) {
+                throw InvalidInputException("rule", line, where + ": rule needs a name");
+            }
+            Rule rule;
+            rule.name = tokens[1];
+            if (!rule.name.empty() && rule.name.back() == ':') rule.name.pop_back();
+            size_t pos = 2;
+            if (pos < tokens.size() && tokens[pos] == ":") ++pos;
+            for (size_t i = pos; i < tokens.size(); ++i) {
+                if (!rule.source.empty()) rule.source += ' ';
+                rule.source += tokens[i];
+            }
+
+            rule.whenBegin = static_cast<uint32_t>(set.program.size());
+            if (pos < tokens.size() && tokens[pos] == "when") {
+                ++pos;
+                set.compileCondition(tokens, pos, where);
+                while (pos < tokens.size() && tokens[pos] == "and") set.compileCondition(tokens, ++pos, where);
+            }
+            rule.requireBegin = static_cast<uint32_t>(set.program.size());
+            if (pos >= tokens.size() || tokens[pos] != "require") {
+                throw InvalidInputException("rule", line, where + ": expected 'require'");
+            }
+            ++pos;
+            set.compileCondition(tokens, pos, where);
+            while (pos < tokens.size() && tokens[pos] == "and") set.compileCondition(tokens, ++pos, where);
+            if (pos != tokens.size()) {
+                throw InvalidInputException("rule", line, where + ": unexpected '" + tokens[pos] + "'");
+            }
+            rule.end = static_cast<uint32_t>(set.program.size());
+            set.rules.push_back(std::move(rule));
+
+        } else {
+            throw InvalidInputException("rule", line, where + ": unknown directive '" + tokens[0] + "'");
+        }
+    }
+    return set;
+}
+
+RuleSet RuleSet::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return RuleSet();
+    return compile(file, path);
+}
@@ -0,0 +1,128 @@
+#include "../include/SeatSubscriptions.h"
+#include <algorithm>
+
+bool SeatFilter::matches(CourseCode code) const {
+    return code.view().substr(0, codePrefix.size()) == codePrefix;
+}
+
+bool SeatFilter::matches(const Section& section) const {
+    if (day < 0) return true;
+    for (const auto& meeting : section.getMeetings()) {
+        if (Section::dayIndex(meeting.dayOfWeek) == day) return true;
+    }
+    return false;
+}
+
+SeatSubscriptions::SeatSubscriptions() : nextId(1) {}
+
+void SeatSubscriptions::attach(const Course& course, Id id, int day, const Callback& callback) {
+    auto inserted = watches.try_emplace(course.getCode());
+    Watch& watch = inserted.first->second;
+    if (inserted.second) {
+        // Changes are measured from the state when watching starts
+        watch.open = course.seatsRemaining() > 0;
+        for (const auto& section : course.getSections()) {
+            watch.sectionOpen.emplace_back(section.getSectionID(), section.seatsRemaining() > 0);
+        }
+    }
+    watch.subscribers.push_back(Subscriber{id, day, callback});
+    coursesOf[id].push_back(course.getCode());
+}
+
+SeatSubscriptions::Id SeatSubscriptions::subscribe(const Course& course, Callback callback) {
+    Id id = nextId++;
+    attach(course, id, -1, callback);
+    return id;
+}
+
+SeatSubscriptions::Id SeatSubscriptions::subscribe(const SeatFilter& filter, const CourseStore& courses,
+                                                   Callback callback) {
+    Id id = nextId++;
+    coursesOf[id];   // Registered even if no course matches yet
+    for (const auto& course : courses) {
+        if (filter.matches(course.getCode())) attach(course, id, filter.day, callback);
+    }
+    filters.push_back(FilterSubscription{id, filter, std::move(callback)});
+    return id;
+}
+
+void SeatSubscriptions::unsubscribe(Id id) {
+    auto it = coursesOf.find(id);
+    if (it == coursesOf.end()) return;
+    for (const auto& code : it->second) {
+        auto watch = watches.find(code);
+        if (watch == watches.end()) continue;
+        auto& subscribers = watch->second.subscribers;
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                         [id](const Subscriber& s) { return s.id == id; }),
+                          subscribers.end());
+        if (subscribers.empty()) watches.erase(watch);
+    }
+    coursesOf.erase(it);
+    filters.erase(std::remove_if(filters.begin(), filters.end(),
+                                 [id](const FilterSubscription& f) { return f.id == id; }),
+                  filters.end());
+}
+
+void SeatSubscriptions::onSeatsChanged(const Course& course) {
+    auto it = watches.find(course.getCode());
+    if (it == watches.end()) return;
+    Watch& watch = it->second;
+
+    // Collected first so a callback may unsubscribe
+    std::vector<std::pair<Callback, SeatNotice>> due;
+    bool open = course.seatsRemaining() > 0;
+    if (open != watch.open) {
+        watch.open = open;
+        SeatNotice notice{course.getCode(), "", course.seatsRemaining(), open};
+        for (const auto& subscriber : watch.subscribers) {
+            if (subscriber.day < 0) due.emplace_back(subscriber.callback, notice);
+        }
+    }
+
+    std::vector<std::pair<std::string, bool>> sectionOpen;
+    sectionOpen.reserve(course.getSections().size());
+    for (const auto& section : course.getSections()) {
+        bool now = section.seatsRemaining() > 0;
+        bool before = false;   // A new section counts as having been full
+        for (const auto& entry : watch.sectionOpen) {
+            if (entry.first == section.getSectionID()) before = entry.second;
+        }
+        sectionOpen.emplace_back(section.getSectionID(), now);
+        if (now == before) continue;
+        SeatNotice notice{course.getCode(), section.getSectionID(), section.seatsRemaining(), now};
+        for (const auto& subscriber : watch.subscribers) {
+            if (subscriber.day >= 0 && SeatFilter{"", subscriber.day}.matches(section)) {
+                due.emplace_back(subscriber.callback, notice);
+            }
+        }
+    }
+    watch.sectionOpen = std::move(sectionOpen);
+
+    for (const auto& entry : due) entry.first(entry.second);
+}
+
+void SeatSubscriptions::onCourseAdded(const Course& course) {
+    for (const auto& subscription : filters) {
+        if (subscription.filter.matches(course.getCode())) {
+            attach(course, subscription.id, subscription.filter.day, subscription.callback);
+        }
+    }
+}
+
+void SeatSubscriptions::onCourseRemoved(CourseCode code) {
+    auto watch = watches.find(code);
+    if (watch == watches.end()) return;
+    for (const auto& subscriber : watch->second.subscribers) {
+        auto& codes = coursesOf[subscriber.id];
+        codes.erase(std::remove(codes.begin(), codes.end(), code), codes.end());
+    }
+    watches.erase(watch);
+}
+
+std::vector<CourseCode> SeatSubscriptions::watchedCourses() const {
+    std::vector<CourseCode> codes;
+    codes.reserve(watches.size());
+    for (const auto& entry : watches) codes.push_back(entry.first);
+    return codes;
+}
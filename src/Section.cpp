@@ -0,0 +1,188 @@
+#include "../include/Section.h"
+#include "../include/CustomExceptions.h"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+// ---------------- Meeting ----------------
+
+Meeting::Meeting() : dayOfWeek(""), startTime(""), endTime(""), weekStart(0), weekEnd(0) {}
+
+Meeting::Meeting(const std::string& dayOfWeek, const std::string& startTime, const std::string& endTime)
+    : dayOfWeek(dayOfWeek), startTime(startTime), endTime(endTime) {
+    int day = Section::dayIndex(dayOfWeek);
+    int base = (day < 0 ? 0 : day) * 24 * 60;
+    weekStart = base + Section::timeToMinutes(startTime);
+    weekEnd = base + Section::timeToMinutes(endTime);
+}
+
+bool Meeting::overlaps(const Meeting& other) const {
+    return weekStart < other.weekEnd && weekEnd > other.weekStart;
+}
+
+std::string Meeting::toString() const {
+    return dayOfWeek + " " + startTime + "-" + endTime;
+}
+
+// ---------------- Section ----------------
+
+Section::Section() : sectionID(""), capacity(0) {}
+
+Section::Section(const std::string& sectionID, int capacity)
+    : sectionID(sectionID), capacity(capacity) {}
+
+Section::Section(const std::string& sectionID, int capacity, const std::vector<Meeting>& meetings)
+    : sectionID(sectionID), capacity(capacity) {
+    setMeetings(meetings);
+}
+
+const std::string& Section::getSectionID() const {
+    return sectionID;
+}
+
+int Section::getCapacity() const {
+    return capacity;
+}
+
+int Section::seatsRemaining() const {
+    return capacity - static_cast<int>(enrolledStudentIDs.size());
+}
+
+const std::vector<StudentId>& Section::getEnrolledStudentIDs() const {
+    return enrolledStudentIDs;
+}
+
+const std::vector<Meeting>& Section::getMeetings() const {
+    return meetings;
+}
+
+void Section::setCapacity(int newCapacity) {
+    capacity = newCapacity;
+}
+
+void Section::setMeetings(const std::vector<Meeting>& newMeetings) {
+    meetings = newMeetings;
+    std::sort(meetings.begin(), meetings.end(), [](const Meeting& a, const Meeting& b) {
+        return a.weekStart < b.weekStart;
+    });
+}
+
+void Section::addMeeting(const Meeting& meeting) {
+    auto pos = std::upper_bound(meetings.begin(), meetings.end(), meeting,
+        [](const Meeting& a, const Meeting& b) { return a.weekStart < b.weekStart; });
+    meetings.insert(pos, meeting);
+}
+
+bool Section::isStudentEnrolled(StudentId studentID) const {
+    return std::find(enrolledStudentIDs.begin(), enrolledStudentIDs.end(), studentID) != enrolledStudentIDs.end();
+}
+
+void Section::enrollStudent(StudentId studentID, CourseCode courseCode) {
+    if (isStudentEnrolled(studentID)) {
+        throw DuplicateEntryException("student enrollment", studentID + " in " + courseCode);
+    }
+    if (seatsRemaining() <= 0) {
+        throw CourseFullException(courseCode + " section " + sectionID);
+    }
+    enrolledStudentIDs.push_back(studentID);
+}
+
+void Section::dropStudent(StudentId studentID, CourseCode courseCode) {
+    auto it = std::find(enrolledStudentIDs.begin(), enrolledStudentIDs.end(), studentID);
+    if (it == enrolledStudentIDs.end()) {
+        throw RegistrationException("Student not enrolled in " + courseCode);
+    }
+    enrolledStudentIDs.erase(it);
+}
+
+void Section::appendRoster(const std::vector<StudentId>& studentIDs) {
+    enrolledStudentIDs.insert(enrolledStudentIDs.end(), studentIDs.begin(), studentIDs.end());
+}
+
+void Section::clearRoster() {
+    enrolledStudentIDs.clear();
+}
+
+bool Section::hasTimeConflict(const Section& other) const {
+    return findOverlap(meetings, other.meetings) >= 0;
+}
+
+std::string Section::scheduleString() const {
+    std::string result;
+    for (size_t i = 0; i < meetings.size(); ++i) {
+        if (i > 0) result += ',';
+        result += meetings[i].toString();
+    }
+    return result;
+}
+
+static const char* const DAY_NAMES[] = {"Monday", "Tuesday", "Wednesday", "Thursday",
+                                        "Friday", "Saturday", "Sunday"};
+
+// Monday = 0 ... Sunday = 6, -1 if unknown
+int Section::dayIndex(const std::string& dayOfWeek) {
+    for (int i = 0; i < 7; ++i) {
+        if (dayOfWeek == DAY_NAMES[i]) return i;
+    }
+    return -1;
+}
+
+std::string Section::dayName(int dayIndex) {
+    return (dayIndex >= 0 && dayIndex < 7) ? DAY_NAMES[dayIndex] : "";
+}
+
+// Minutes since midnight back to HH:MM
+std::string Section::minutesToTime(int minutes) {
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "%02d:%02d", (minutes / 60) % 24, minutes % 60);
+    return buffer;
+}
+
+// Convert time string (HH:MM) to minutes since midnight
+int Section::timeToMinutes(const std::string& time) {
+    if (time.empty()) return 0;
+    std::istringstream iss(time);
+    int hours, minutes;
+    char colon;
+    if (iss >> hours >> colon >> minutes) {
+        return hours * 60 + minutes;
+    }
+    return 0;
+}
+
+// Parse "Monday 09:00-10:30,Wednesday 09:00-10:30" into meetings
+std::vector<Meeting> Section::parseMeetings(const std::string& spec) {
+    std::vector<Meeting> result;
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        size_t space = item.find(' ');
+        size_t dash = item.find('-', space == std::string::npos ? 0 : space);
+        if (space == std::string::npos || dash == std::string::npos) {
+            throw InvalidInputException("meeting", item, "expected 'Day HH:MM-HH:MM'");
+        }
+        result.emplace_back(item.substr(0, space),
+                            item.substr(space + 1, dash - space - 1),
+                            item.substr(dash + 1));
+    }
+    return result;
+}
+
+// Two-pointer sweep over both sorted lists: advance whichever meeting ends first.
+// Assumes meetings within each list do not overlap each other, which holds for
+// a student's accepted schedule and for a validated section.
+int Section::findOverlap(const std::vector<Meeting>& schedule, const std::vector<Meeting>& candidate) {
+    size_t i = 0, j = 0;
+    while (i < schedule.size() && j < candidate.size()) {
+        if (schedule[i].overlaps(candidate[j])) {
+            return static_cast<int>(i);
+        }
+        if (schedule[i].weekEnd <= candidate[j].weekEnd) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,227 @@
+#include "../include/Session.h"
+
+SessionExecutor::SessionExecutor(size_t threads) : stopping(false) {
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([this]() {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            while (true) {
+                wakeup.wait(lock, [this]() { return stopping || !runnable.empty(); });
+                if (runnable.empty()) return;   // Stopping and drained
+                Session* session = runnable.front();
+                runnable.pop_front();
+                lock.unlock();
+                runStep(*session);
+                lock.lock();
+            }
+        });
+    }
+}
+
+SessionExecutor::~SessionExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void SessionExecutor::schedule(Session& session) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        runnable.push_back(&session);
+    }
+    wakeup.notify_one();
+}
+
+size_t SessionExecutor::runPending() {
+    size_t steps = 0;
+    while (true) {
+        Session* session = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (runnable.empty()) return steps;
+            session = runnable.front();
+            runnable.pop_front();
+        }
+        runStep(*session);
+        ++steps;
+    }
+}
+
+void SessionExecutor::waitForWork() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    wakeup.wait(lock, [this]() { return stopping || !runnable.empty(); });
+}
+
+void SessionExecutor::runStep(Session& session) {
+    session.beginStep();
+    {
+        std::lock_guard<std::mutex> lock(engineMutex);
+        session.resumePoint.resume();   // Runs until the session needs input or returns
+    }
+    session.endStep();
+}
+
+Session::Session(SessionExecutor& executor, OutputSink sink)
+    : executor(executor), sink(std::move(sink)), stepsRunning(0), closed(false), inputEnded(false),
+      waiting(false), parked(false), woken(false), finishing(false), done(false), task(nullptr) {}
+
+SessionTask<> Session::run(SessionTask<> body) {
+    try {
+        co_await body;
+    } catch (const std::exception& e) {
+        buffer << "Unexpected error: " << e.what() << std::endl;
+    } catch (...) {
+        buffer << "Unexpected error" << std::endl;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    stashOutput();
+    finishing = true;
+}
+
+void Session::start(SessionTask<> body) {
+    task = run(std::move(body));
+    resumePoint = task.handle;
+    executor.schedule(*this);
+}
+
+void Session::input(std::string line) {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed) return;
+        lines.push_back(std::move(line));
+        wake = std::exchange(waiting, false);
+    }
+    if (wake) executor.schedule(*this);
+}
+
+void Session::close() {
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        wake = std::exchange(waiting, false);
+    }
+    if (wake) executor.schedule(*this);
+}
+
+bool Session::finished() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return done;
+}
+
+void Session::waitUntilFinished() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finishedSignal.wait(lock, [this]() { return done; });
+}
+
+void Session::notify(const std::string& text) {
+    std::lock_guard<std::mutex> flushLock(flushMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (done) return;
+        if (stepsRunning > 0) {
+            pendingOutput += text;
+            return;
+        }
+    }
+    if (sink) sink(text);
+}
+
+bool Session::needsInput() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return waiting;
+}
+
+void Session::wake() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!parked) {
+            woken = true;
+            return;
+        }
+        parked = false;
+    }
+    executor.schedule(*this);
+}
+
+bool Session::eof() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return inputEnded;
+}
+
+void Session::stashOutput() {
+    pendingOutput += buffer.str();
+    buffer.str("");
+}
+
+void Session::beginStep() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++stepsRunning;
+}
+
+void Session::endStep() {
+    bool last = false;
+    {
+        std::lock_guard<std::mutex> flushLock(flushMutex);
+        std::string output;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            output.swap(pendingOutput);
+            last = --stepsRunning == 0 && finishing;
+        }
+        if (!output.empty() && sink) sink(output);
+    }
+    // Nothing touches the session after this; the frontend may destroy it
+    if (last) {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        finishedSignal.notify_all();
+    }
+}
+
+bool Session::ParkAwaiter::await_ready() {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    session.stashOutput();
+    return std::exchange(session.woken, false);
+}
+
+bool Session::ParkAwaiter::await_suspend(std::coroutine_handle<> awaiting) {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    if (std::exchange(session.woken, false)) return false;   // Woken meanwhile
+    session.resumePoint = awaiting;
+    session.parked = true;
+    return true;
+}
+
+bool Session::LineAwaiter::await_ready() {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    session.stashOutput();
+    return !session.lines.empty() || session.closed;
+}
+
+bool Session::LineAwaiter::await_suspend(std::coroutine_handle<> awaiting) {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    if (!session.lines.empty() || session.closed) return false;   // Arrived meanwhile
+    session.resumePoint = awaiting;
+    session.waiting = true;
+    return true;
+}
+
+std::string Session::LineAwaiter::await_resume() {
+    std::lock_guard<std::mutex> lock(session.mutex);
+    if (session.lines.empty()) {
+        session.inputEnded = true;
+        return "";
+    }
+    std::string line = std::move(session.lines.front());
+    session.lines.pop_front();
+    return line;
+}
+
+SessionTask<bool> Session::askForMore() {
+    std::string answer = co_await prompt("-- Press Enter for more, or q to stop: ");
+    co_return !eof() && answer != "q" && answer != "Q";
+}
@@ -1,23 +1,17 @@
 #include "../include/Student.h"
 #include <iostream>
 #include <algorithm>
+#include <utility>
 using namespace std;
 
 // Default Constructor
-Student::Student() : User() {
-    studentID = "";
-    major = "";
-    gpa = 0.0;
-}
+Student::Student() : User(), gpa(0.0) {}
 
 // Parameterized Constructor
 Student::Student(string username, string password, string email, string name, 
-                 string userID, string studentID, string major, double gpa)
-    : User(username, password, email, name, userID) {
-    this->studentID = studentID;
-    this->major = major;
-    this->gpa = gpa;
-}
+                 string userID, StudentId studentID, string major, double gpa)
+    : User(std::move(username), std::move(password), std::move(email), std::move(name), std::move(userID)),
+      studentID(studentID), major(std::move(major)), gpa(gpa) {}
 
 // Destructor
 Student::~Student() {
@@ -25,11 +19,11 @@ Student::~Student() {
 }
 
 // Getters
-string Student::getStudentID() const {
+StudentId Student::getStudentID() const {
     return studentID;
 }
 
-string Student::getMajor() const {
+const string& Student::getMajor() const {
     return major;
 }
 
@@ -37,50 +31,64 @@ double Student::getGPA() const {
     return gpa;
 }
 
-vector<string> Student::getEnrolledCourses() const {
+const vector<CourseCode>& Student::getEnrolledCourses() const {
     return enrolledCourses;
 }
 
+const vector<CourseCode>& Student::getCompletedCourses() const {
+    return completedCourses;
+}
+
 // Setters
-void Student::setStudentID(string studentID) {
+void Student::setStudentID(StudentId studentID) {
     this->studentID = studentID;
 }
 
 void Student::setMajor(string major) {
-    this->major = major;
+    this->major = std::move(major);
 }
 
 void Student::setGPA(double gpa) {
     this->gpa = gpa;
 }
 
-void Student::setEnrolledCourses(const vector<string>& courses) {
-    enrolledCourses = courses;
+void Student::setEnrolledCourses(vector<CourseCode> courses) {
+    enrolledCourses = std::move(courses);
+}
+
+void Student::setCompletedCourses(vector<CourseCode> courses) {
+    completedCourses = std::move(courses);
 }
 
 // Add a course to student's enrolled list
-void Student::addCourse(string courseCode) {
+void Student::addCourse(CourseCode courseCode) {
     if (!isEnrolledIn(courseCode)) {
         enrolledCourses.push_back(courseCode);
-        cout << "Course " << courseCode << " added (placeholder, Member 2 will handle capacity/conflicts)." << endl;
     } else {
         cout << "Already enrolled in " << courseCode << endl;
     }
 }
 
 // Remove a course from student's enrolled list
-void Student::removeCourse(string courseCode) {
+void Student::removeCourse(CourseCode courseCode) {
     auto it = find(enrolledCourses.begin(), enrolledCourses.end(), courseCode);
     if (it != enrolledCourses.end()) {
         enrolledCourses.erase(it);
-        cout << "Course " << courseCode << " removed (placeholder)." << endl;
     } else {
         cout << "You are not enrolled in " << courseCode << endl;
     }
 }
 
+// Swap one enrolled course code for another
+void Student::replaceCourse(CourseCode from, CourseCode to) {
+    auto it = find(enrolledCourses.begin(), enrolledCourses.end(), from);
+    if (it != enrolledCourses.end()) {
+        *it = to;
+    }
+}
+
 // Check if student is enrolled in a specific course
-bool Student::isEnrolledIn(string courseCode) const {
+bool Student::isEnrolledIn(CourseCode courseCode) const {
     return find(enrolledCourses.begin(), enrolledCourses.end(), courseCode) 
            != enrolledCourses.end();
 }
@@ -90,20 +98,32 @@ int Student::getTotalEnrolledCourses() const {
     return enrolledCourses.size();
 }
 
+// Record a finished course (once)
+void Student::addCompletedCourse(CourseCode courseCode) {
+    if (!hasCompleted(courseCode)) {
+        completedCourses.push_back(courseCode);
+    }
+}
+
+bool Student::hasCompleted(CourseCode courseCode) const {
+    return find(completedCourses.begin(), completedCourses.end(), courseCode)
+           != completedCourses.end();
+}
+
 // POLYMORPHISM: Override displayMenu() from User
 // POLYMORPHISM: Override displayMenu() from User
-void Student::displayMenu() {
-    cout << "\n========================================\n";
-    cout << "         STUDENT MENU                   \n";
-    cout << "========================================\n";
-    cout << " 1. View My Information\n";
-    cout << " 2. View My Enrolled Courses\n";
-    cout << " 3. View All Available Courses\n";
-    cout << " 4. Register for a Course\n";
-    cout << " 5. Drop a Course\n";
-    cout << " 6. Logout\n";
-    cout << "========================================\n";
-    cout << "Enter your choice: ";
+void Student::displayMenu(ostream& out) {
+    out << "\n========================================\n";
+    out << "         STUDENT MENU                   \n";
+    out << "========================================\n";
+    out << " 1. View My Information\n";
+    out << " 2. View My Enrolled Courses\n";
+    out << " 3. View All Available Courses\n";
+    out << " 4. Register for a Course\n";
+    out << " 5. Drop a Course\n";
+    out << " 6. Logout\n";
+    out << "========================================\n";
+    out << "Enter your choice: ";
 }
 
 // POLYMORPHISM: Override getUserType() from User
@@ -112,34 +132,35 @@ string Student::getUserType() const {
 }
 
 // Display student-specific information
-void Student::displayStudentInfo() const {
-    cout << "\n=====================================" << endl;
-    cout << "      STUDENT INFORMATION            " << endl;
-    cout << "=====================================" << endl;
-    cout << "Name: " << name << endl;
-    cout << "Username: " << username << endl;
-    cout << "Email: " << email << endl;
-    cout << "Student ID: " << studentID << endl;
-    cout << "Major: " << major << endl;
-    cout << "GPA: " << gpa << endl;
-    cout << "Enrolled Courses: " << enrolledCourses.size() << endl;
-    cout << "=====================================\n" << endl;
+void Student::displayStudentInfo(ostream& out) const {
+    out << "\n=====================================" << endl;
+    out << "      STUDENT INFORMATION            " << endl;
+    out << "=====================================" << endl;
+    out << "Name: " << name << endl;
+    out << "Username: " << username << endl;
+    out << "Email: " << email << endl;
+    out << "Student ID: " << studentID << endl;
+    out << "Major: " << major << endl;
+    out << "GPA: " << gpa << endl;
+    out << "Enrolled Courses: " << enrolledCourses.size() << endl;
+    out << "Completed Courses: " << completedCourses.size() << endl;
+    out << "=====================================\n" << endl;
 }
 
 // Display all enrolled courses
-void Student::displayEnrolledCourses() const {
-    cout << "\n=====================================" << endl;
-    cout << "      ENROLLED COURSES               " << endl;
-    cout << "=====================================" << endl;
+void Student::displayEnrolledCourses(ostream& out) const {
+    out << "\n=====================================" << endl;
+    out << "      ENROLLED COURSES               " << endl;
+    out << "=====================================" << endl;
     
     if (enrolledCourses.empty()) {
-        cout << "You are not enrolled in any courses yet." << endl;
+        out << "You are not enrolled in any courses yet." << endl;
     } else {
-        cout << "Total Courses: " << enrolledCourses.size() << endl;
-        cout << "-------------------------------------" << endl;
+        out << "Total Courses: " << enrolledCourses.size() << endl;
+        out << "-------------------------------------" << endl;
         for (int i = 0; i < enrolledCourses.size(); i++) {
-            cout << (i + 1) << ". " << enrolledCourses[i] << endl;
+            out << (i + 1) << ". " << enrolledCourses[i] << endl;
         }
     }
-    cout << "=====================================\n" << endl;
+    out << "=====================================\n" << endl;
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "../include/StudentDirectory.h"
+#include "../include/Keys.h"
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+
+namespace {
+
+// Field 'index' (0-based) of a '|'-separated line, without copying
+std::string_view fieldOf(std::string_view line, int index) {
+    size_t start = 0;
+    for (int i = 0; i < index; ++i) {
+        start = line.find('|', start);
+        if (start == std::string_view::npos) return std::string_view();
+        ++start;
+    }
+    size_t end = line.find('|', start);
+    return line.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+}
+
+const int USERNAME_FIELD = 0;
+const int STUDENT_ID_FIELD = 5;
+
+} // namespace
+
+size_t StudentDirectory::build(const ShardLayout& layout) {
+    byUsername.clear();
+    byStudentID.clear();
+    std::vector<std::vector<Entry>> names(layout.count());
+    std::vector<std::vector<Entry>> ids(layout.count());
+    std::vector<size_t> skipped(layout.count(), 0);
+    forEachShard(layout.count(), [&](size_t shard) {
+        std::ifstream file(layout.path(shard), std::ios::binary);
+        if (!file.is_open()) return;
+        std::string line;
+        uint64_t offset = 0;
+        while (std::getline(file, line)) {
+            uint64_t next = offset + line.size() + 1;
+            if (!line.empty()) {
+                std::string_view studentID = fieldOf(line, STUDENT_ID_FIELD);
+                if (!StudentId::fits(studentID)) {
+                    ++skipped[shard];
+                } else {
+                    uint32_t s = static_cast<uint32_t>(shard);
+                    names[shard].push_back(Entry{ShardLayout::hashKey(fieldOf(line, USERNAME_FIELD)), s, offset});
+                    ids[shard].push_back(Entry{ShardLayout::hashKey(studentID), s, offset});
+                }
+            }
+            offset = next;
+        }
+    });
+    for (size_t shard = 0; shard < layout.count(); ++shard) {
+        byUsername.insert(byUsername.end(), names[shard].begin(), names[shard].end());
+        byStudentID.insert(byStudentID.end(), ids[shard].begin(), ids[shard].end());
+    }
+    std::sort(byUsername.begin(), byUsername.end());
+    std::sort(byStudentID.begin(), byStudentID.end());
+    size_t total = 0;
+    for (size_t count : skipped) total += count;
+    return total;
+}
+
+void StudentDirectory::clear() {
+    byUsername.clear();
+    byStudentID.clear();
+    recency.clear();
+    recencyPosition.clear();
+    pinCount.clear();
+    dirtySlots.clear();
+}
+
+void StudentDirectory::replaceShard(uint32_t shard, const std::vector<LineInfo>& lines) {
+    auto inShard = [shard](const Entry& entry) { return entry.shard == shard; };
+    byUsername.erase(std::remove_if(byUsername.begin(), byUsername.end(), inShard), byUsername.end());
+    byStudentID.erase(std::remove_if(byStudentID.begin(), byStudentID.end(), inShard), byStudentID.end());
+    for (const auto& line : lines) {
+        byUsername.push_back(Entry{ShardLayout::hashKey(line.username), shard, line.offset});
+        byStudentID.push_back(Entry{ShardLayout::hashKey(line.studentID), shard, line.offset});
+    }
+    std::sort(byUsername.begin(), byUsername.end());
+    std::sort(byStudentID.begin(), byStudentID.end());
+}
+
+std::vector<StudentLocation> StudentDirectory::find(const std::vector<Entry>& entries, uint64_t hash) {
+    std::vector<StudentLocation> found;
+    auto range = std::equal_range(entries.begin(), entries.end(), Entry{hash, 0, 0});
+    for (auto it = range.first; it != range.second; ++it) {
+        found.push_back(StudentLocation{it->shard, it->offset});
+    }
+    return found;
+}
+
+std::vector<StudentLocation> StudentDirectory::findUsername(const std::string& username) const {
+    return find(byUsername, ShardLayout::hashKey(username));
+}
+
+std::vector<StudentLocation> StudentDirectory::findStudentID(const std::string& studentID) const {
+    return find(byStudentID, ShardLayout::hashKey(studentID));
+}
+
+bool StudentDirectory::readLine(const ShardLayout& layout, const StudentLocation& location, std::string& line) {
+    std::ifstream file(layout.path(location.shard), std::ios::binary);
+    if (!file.is_open()) return false;
+    file.seekg(static_cast<std::streamoff>(location.offset));
+    return static_cast<bool>(std::getline(file, line));
+}
+
+StudentDirectory::LineInfo StudentDirectory::lineKeys(const std::string& line, uint64_t offset) {
+    return LineInfo{std::string(fieldOf(line, USERNAME_FIELD)), std::string(fieldOf(line, STUDENT_ID_FIELD)), offset};
+}
+
+void StudentDirectory::touch(uint32_t slot) {
+    auto it = recencyPosition.find(slot);
+    if (it != recencyPosition.end()) {
+        recency.splice(recency.begin(), recency, it->second);
+    } else {
+        recency.push_front(slot);
+        recencyPosition[slot] = recency.begin();
+    }
+}
+
+void StudentDirectory::forget(uint32_t slot) {
+    auto it = recencyPosition.find(slot);
+    if (it != recencyPosition.end()) {
+        recency.erase(it->second);
+        recencyPosition.erase(it);
+    }
+    pinCount.erase(slot);
+    dirtySlots.erase(slot);
+}
+
+void StudentDirectory::pin(uint32_t slot) {
+    ++pinCount[slot];
+}
+
+void StudentDirectory::unpin(uint32_t slot) {
+    // The entry stays at zero until forget() so the next login of a resident
+    // record does not allocate a map node
+    auto it = pinCount.find(slot);
+    if (it != pinCount.end() && it->second > 0) --it->second;
+}
+
+void StudentDirectory::markDirty(uint32_t slot) {
+    dirtySlots.insert(slot);
+}
+
+bool StudentDirectory::evictionCandidate(uint32_t& slot) const {
+    for (auto it = recency.rbegin(); it != recency.rend(); ++it) {
+        auto pins = pinCount.find(*it);
+        bool pinned = pins != pinCount.end() && pins->second > 0;
+        if (!pinned && dirtySlots.count(*it) == 0) {
+            slot = *it;
+            return true;
+        }
+    }
+    return false;
+}
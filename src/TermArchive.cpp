@@ -0,0 +1,30 @@
+#include "../include/TermArchive.h"
+#include <utility>
+
+TermArchive::TermArchive(std::string termID) : termID(std::move(termID)) {}
+
+void TermArchive::buildIndexes() {
+    courseIndex.clear();
+    studentCourses.clear();
+    for (auto it = courses.begin(); it != courses.end(); ++it) {
+        courseIndex[it->getCode()] = it.handle();
+        for (const auto& section : it->getSections()) {
+            for (const auto& id : section.getEnrolledStudentIDs()) {
+                studentCourses[id].push_back(it->getCode());
+            }
+        }
+    }
+}
+
+const Course* TermArchive::getCourse(std::string_view code) const {
+    CourseCode key;
+    if (!CourseCode::tryParse(code, key)) return nullptr;
+    auto it = courseIndex.find(key);
+    return it == courseIndex.end() ? nullptr : courses.get(it->second);
+}
+
+const std::vector<CourseCode>& TermArchive::coursesOf(StudentId studentID) const {
+    static const std::vector<CourseCode> none;
+    auto it = studentCourses.find(studentID);
+    return it == studentCourses.end() ? none : it->second;
+}
@@ -1,24 +1,15 @@
 #include "../include/User.h"
 #include <iostream>
+#include <utility>
 using namespace std;
 
 // Default Constructor
-User::User() {
-    username = "";
-    password = "";
-    email = "";
-    name = "";
-    userID = "";
-}
+User::User() {}
 
 // Parameterized Constructor
-User::User(string username, string password, string email, string name, string userID) {
-    this->username = username;
-    this->password = password;
-    this->email = email;
-    this->name = name;
-    this->userID = userID;
-}
+User::User(string username, string password, string email, string name, string userID)
+    : username(std::move(username)), password(std::move(password)), email(std::move(email)),
+      name(std::move(name)), userID(std::move(userID)) {}
 
 // Destructor
 User::~User() {
@@ -26,51 +17,51 @@ User::~User() {
 }
 
 // Getters
-string User::getUsername() const {
+const string& User::getUsername() const {
     return username;
 }
 
-string User::getPassword() const {
+const string& User::getPassword() const {
     return password;
 }
 
-string User::getEmail() const {
+const string& User::getEmail() const {
     return email;
 }
 
-string User::getName() const {
+const string& User::getName() const {
     return name;
 }
 
-string User::getUserID() const {
+const string& User::getUserID() const {
     return userID;
 }
 
 // Setters
 void User::setUsername(string username) {
-    this->username = username;
+    this->username = std::move(username);
 }
 
 void User::setPassword(string password) {
-    this->password = password;
+    this->password = std::move(password);
 }
 
 void User::setEmail(string email) {
-    this->email = email;
+    this->email = std::move(email);
 }
 
 void User::setName(string name) {
-    this->name = name;
+    this->name = std::move(name);
 }
 
 // Display user information
-void User::displayInfo() const {
-    cout << "\n=====================================" << endl;
-    cout << "       USER INFORMATION              " << endl;
-    cout << "=====================================" << endl;
-    cout << "Name: " << name << endl;
-    cout << "Username: " << username << endl;
-    cout << "Email: " << email << endl;
-    cout << "User ID: " << userID << endl;
-    cout << "=====================================\n" << endl;
+void User::displayInfo(ostream& out) const {
+    out << "\n=====================================" << endl;
+    out << "       USER INFORMATION              " << endl;
+    out << "=====================================" << endl;
+    out << "Name: " << name << endl;
+    out << "Username: " << username << endl;
+    out << "Email: " << email << endl;
+    out << "User ID: " << userID << endl;
+    out << "=====================================\n" << endl;
 }
\ No newline at end of file
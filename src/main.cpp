@@ -1,248 +1,456 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <vector>
 #include "../include/User.h"
 #include "../include/Student.h"
 #include "../include/Admin.h"
 #include "../include/RegistrationSystem.h"
 #include "../include/FileManager.h"
+#include "../include/InputValidator.h"
 #include "../include/CustomExceptions.h"  
+#include "../include/Session.h"
+#include "../include/AdmissionController.h"
 
 using namespace std;
 
-// Helper function to prompt for input
-static string prompt(const string& label) {
-    cout << label;
-    string value;
-    getline(cin, value);
-    return value;
+// Listings are shown a page at a time
+static const size_t PAGE_SIZE = 20;
+
+// Runs one request through the admission controller. The session is parked
+// until it completes, which releases the engine lock for the dispatcher.
+template <typename Submit>
+static SessionTask<RegistrationResult> admit(Session& session, Submit submit) {
+    future<RegistrationResult> result = submit([&session]() { session.wake(); });
+    co_await session.park();
+    co_return result.get();
 }
 
 // Student session with polymorphism demonstration
-static void studentSession(Student& student, RegistrationSystem& regSys) {
+static SessionTask<> studentSession(Session& session, Student& student, RegistrationSystem& regSys,
+                                    AdmissionController& admission) {
+    ostream& out = session.out();
     bool inSession = true;
     User* userPtr = &student;  // POLYMORPHISM: Base class pointer to derived object
+    vector<SeatSubscriptions::Id> seatWatches;   // Dropped at logout
     
-    while (inSession) {
-        cout << "\n========================================\n";
-        cout << "         STUDENT MENU                   \n";
-        cout << "========================================\n";
-        cout << " 1. View My Information\n";
-        cout << " 2. View My Enrolled Courses\n";
-        cout << " 3. View All Available Courses\n";
-        cout << " 4. Register for a Course\n";
-        cout << " 5. Drop a Course\n";
-        cout << " 6. Logout\n";
-        cout << "========================================\n";
-        cout << "Enter your choice: ";
+    while (inSession && !session.eof()) {
+        out << "\n========================================\n";
+        out << "         STUDENT MENU                   \n";
+        out << "========================================\n";
+        out << " 1. View My Information\n";
+        out << " 2. View My Enrolled Courses\n";
+        out << " 3. View All Available Courses\n";
+        out << " 4. Register for a Course\n";
+        out << " 5. Drop a Course\n";
+        out << " 6. Logout\n";
+        out << " 7. Search Open Sections\n";
+        out << " 8. View Enrollment History\n";
+        out << " 9. Swap a Course (keeps your seat until the new one is confirmed)\n";
+        out << "10. Watch for Open Seats (notified while logged in)\n";
+        out << "========================================\n";
+        out << "Enter your choice: ";
         
-        string choice;
-        getline(cin, choice);
+        string choice = co_await session.readLine();
+        if (session.eof()) break;
 
         try {
             if (choice == "1") {
                 // View student info
-                student.displayStudentInfo();
+                student.displayStudentInfo(out);
                 
             } else if (choice == "2") {
                 // View enrolled courses with details
-                student.displayEnrolledCourses();
+                student.displayEnrolledCourses(out);
                 
                 // Show detailed course information
                 const auto& enrolledCodes = student.getEnrolledCourses();
                 if (!enrolledCodes.empty()) {
-                    cout << "\n--- Course Details ---\n";
+                    out << "\n--- Course Details ---\n";
                     for (const auto& code : enrolledCodes) {
-                        const auto& courses = regSys.getCourses();
-                        for (const auto& course : courses) {
-                            if (course.getCode() == code) {
-                                cout << "\nCourse: " << course.getCode() << " - " << course.getTitle() << endl;
-                                cout << "Schedule: " << course.getDayOfWeek() << " " 
-                                     << course.getStartTime() << " - " << course.getEndTime() << endl;
-                                break;
-                            }
+                        const Course* course = regSys.getCourse(code);
+                        if (!course) continue;
+                        out << "\nCourse: " << course->getCode() << " - " << course->getTitle() << endl;
+                        const Section* section = course->findSectionOf(student.getStudentID());
+                        if (section) {
+                            out << "Section: " << section->getSectionID() << endl;
+                            out << "Schedule: " << section->scheduleString() << endl;
                         }
                     }
                 }
                 
             } else if (choice == "3") {
                 // View all available courses
-                regSys.listCourses();
+                ListingCursor cursor;
+                do {
+                    regSys.renderCatalogPage(CatalogStyle::Student, cursor, PAGE_SIZE, out);
+                } while (!cursor.done && co_await session.askForMore());
                 
-            } else if (choice == "4") {
-                // Register for a course
-                cout << "\n--- Register for Course ---\n";
-                regSys.listCourses();
+            } else if (choice == "4" && regSys.isAllocationWindowOpen()) {
+                // Allocation window: submit a ranked request instead of registering directly
+                out << "\n--- Submit Seat Request ---\n";
+                out << "Seats are allocated in a batch when the window closes.\n";
+                ListingCursor cursor;
+                regSys.renderCatalogPage(CatalogStyle::Student, cursor, 0, out);
                 
-                string courseCode = prompt("Enter course code to register: ");
+                string line = co_await session.prompt("Course codes in order of preference (e.g., CS101,MATH201:002): ");
+                vector<SeatChoice> choices;
+                stringstream ss(line);
+                string item;
+                while (getline(ss, item, ',')) {
+                    if (item.empty()) continue;
+                    size_t colon = item.find(':');
+                    if (colon == string::npos) {
+                        choices.push_back(SeatChoice{item, ""});
+                    } else {
+                        choices.push_back(SeatChoice{item.substr(0, colon), item.substr(colon + 1)});
+                    }
+                }
                 
                 try {
-                    regSys.registerForCourse(student, courseCode);
-                    cout << "\n✓ Successfully registered for " << courseCode << "!\n";
+                    regSys.submitSeatRequest(student, choices);
+                    out << "\n✓ Request submitted with " << choices.size() << " ranked choice(s).\n";
                 } catch (const RegistrationException& e) {
-                    cout << "✗ Registration failed: " << e.what() << endl;
+                    out << "✗ Request failed: " << e.what() << endl;
+                }
+                
+            } else if (choice == "4") {
+                // Register for a course
+                out << "\n--- Register for Course ---\n";
+                ListingCursor cursor;
+                regSys.renderCatalogPage(CatalogStyle::Student, cursor, 0, out);
+                
+                string courseCode = co_await session.prompt("Enter course code to register: ");
+                string sectionID;
+                const Course* course = regSys.getCourse(courseCode);
+                if (course && course->getSections().size() > 1) {
+                    sectionID = co_await session.prompt("Enter section (blank for any open section): ");
+                }
+                
+                RegistrationResult result = co_await admit(session, [&](function<void()> onReady) {
+                    return admission.submitRegister(student, courseCode, sectionID, std::move(onReady));
+                });
+                if (result.ok()) {
+                    out << "\n✓ Successfully registered for " << courseCode << "!\n";
+                } else {
+                    out << "✗ Registration failed: " << result.message() << endl;
                 }
                 
             } else if (choice == "5") {
                 // Drop a course
-                cout << "\n--- Drop Course ---\n";
-                student.displayEnrolledCourses();
+                out << "\n--- Drop Course ---\n";
+                student.displayEnrolledCourses(out);
                 
                 if (student.getTotalEnrolledCourses() == 0) {
-                    cout << "You are not enrolled in any courses.\n";
+                    out << "You are not enrolled in any courses.\n";
                 } else {
-                    string courseCode = prompt("Enter course code to drop: ");
+                    string courseCode = co_await session.prompt("Enter course code to drop: ");
                     
-                    try {
-                        regSys.dropCourse(student, courseCode);
-                        cout << "\n✓ Successfully dropped " << courseCode << "!\n";
-                    } catch (const RegistrationException& e) {
-                        cout << "✗ Drop failed: " << e.what() << endl;
+                    RegistrationResult result = co_await admit(session, [&](function<void()> onReady) {
+                        return admission.submitDrop(student, courseCode, std::move(onReady));
+                    });
+                    if (result.ok()) {
+                        out << "\n✓ Successfully dropped " << courseCode << "!\n";
+                    } else {
+                        out << "✗ Drop failed: " << result.message() << endl;
                     }
                 }
                 
             } else if (choice == "6") {
                 inSession = false;
-                cout << "Logging out...\n";
+                out << "Logging out...\n";
+            } else if (choice == "7") {
+                // Search Open Sections
+                out << "\n--- Search Open Sections ---\n";
+                string day = co_await session.prompt("Day (e.g., Tuesday, blank for any): ");
+                string after = co_await session.prompt("Starting at or after (HH:MM, blank for any): ");
+                
+                CatalogQuery query;
+                query.openSeatsOnly = true;
+                if (!day.empty()) {
+                    if (!InputValidator::isValidDayOfWeek(day)) {
+                        throw InvalidInputException("day", day, "expected a day such as Monday");
+                    }
+                    query.day = Section::dayIndex(day);
+                }
+                if (!after.empty()) {
+                    if (!InputValidator::isValidTimeFormat(after)) {
+                        throw InvalidInputException("time", after, "expected HH:MM");
+                    }
+                    query.startsAtOrAfter = Section::timeToMinutes(after);
+                }
+                regSys.searchSections(query, out);
+                
+            } else if (choice == "8") {
+                // Enrollment history across archived terms (each loads on first use)
+                out << "\n--- Enrollment History ---\n";
+                const auto& terms = regSys.getArchivedTerms();
+                if (terms.empty()) {
+                    out << "No past terms on record.\n";
+                }
+                for (const auto& termID : terms) {
+                    const TermArchive& term = regSys.getArchivedTerm(termID);
+                    out << termID << ":";
+                    const auto& codes = term.coursesOf(student.getStudentID());
+                    if (codes.empty()) out << " (none)";
+                    for (const auto& code : codes) {
+                        const Course* course = term.getCourse(code);
+                        out << "\n  " << code;
+                        if (course) out << " - " << course->getTitle();
+                    }
+                    out << endl;
+                }
+                out << regSys.getActiveTerm() << " (current): " << student.getTotalEnrolledCourses()
+                     << " course(s)\n";
+            } else if (choice == "9") {
+                // Swap: drop one course and add another (or change section) in one step
+                out << "\n--- Swap Course ---\n";
+                student.displayEnrolledCourses(out);
+                
+                if (student.getTotalEnrolledCourses() == 0) {
+                    out << "You are not enrolled in any courses.\n";
+                } else {
+                    string fromCode = co_await session.prompt("Course code to give up: ");
+                    string toCode = co_await session.prompt("Course code to take instead (same code to change section): ");
+                    string sectionID;
+                    const Course* course = regSys.getCourse(toCode);
+                    if (course && course->getSections().size() > 1) {
+                        sectionID = co_await session.prompt("Enter section (blank for any open section): ");
+                    }
+                    
+                    RegistrationResult result = co_await admit(session, [&](function<void()> onReady) {
+                        return admission.submitSwap(student, fromCode, toCode, sectionID, std::move(onReady));
+                    });
+                    if (result.ok()) {
+                        out << "\n✓ Swapped " << fromCode << " for " << toCode << "!\n";
+                    } else {
+                        out << "✗ Swap failed: " << result.message() << endl;
+                        out << "You are still enrolled in " << fromCode << ".\n";
+                    }
+                }
+            } else if (choice == "10") {
+                // Seat alerts arrive between prompts, even while this session waits for input
+                out << "\n--- Watch for Open Seats ---\n";
+                string code = co_await session.prompt("Course code, or code prefix for a filter (e.g., CS): ");
+                string day = co_await session.prompt("Only sections meeting on (e.g., Monday, blank for any): ");
+                
+                auto alert = [&session](const SeatNotice& notice) {
+                    ostringstream text;
+                    text << "\n[Seat alert] " << notice.course;
+                    if (!notice.sectionID.empty()) text << " section " << notice.sectionID;
+                    if (notice.opened) text << " has " << notice.seatsRemaining << " open seat(s)\n";
+                    else text << " is full again\n";
+                    session.notify(text.str());
+                };
+                if (day.empty() && regSys.getCourse(code)) {
+                    seatWatches.push_back(regSys.watchSeats(code, alert));
+                } else {
+                    SeatFilter filter;
+                    filter.codePrefix = code;
+                    if (!day.empty()) {
+                        if (!InputValidator::isValidDayOfWeek(day)) {
+                            throw InvalidInputException("day", day, "expected a day such as Monday");
+                        }
+                        filter.day = Section::dayIndex(day);
+                    }
+                    seatWatches.push_back(regSys.watchSeats(filter, alert));
+                }
+                out << "✓ Watching " << (code.empty() ? "all courses" : code)
+                    << ". Alerts stop when you log out.\n";
             } else {
-                cout << "Invalid choice. Try again.\n";
+                out << "Invalid choice. Try again.\n";
             }
         } catch (const RegistrationException& e) {
-            cout << "Error: " << e.what() << endl;
+            out << "Error: " << e.what() << endl;
         } catch (const exception& e) {
-            cout << "Unexpected error: " << e.what() << endl;
+            out << "Unexpected error: " << e.what() << endl;
         }
     }
+    for (auto id : seatWatches) regSys.unwatchSeats(id);
 }
 
 // Admin session with polymorphism demonstration
-static void adminSession(Admin& admin, RegistrationSystem& regSys) {
+static SessionTask<> adminSession(Session& session, Admin& admin, RegistrationSystem& regSys) {
+    ostream& out = session.out();
     bool inSession = true;
     User* userPtr = &admin;  // POLYMORPHISM: Base class pointer to derived object
     
-    while (inSession) {
-        userPtr->displayMenu(); // RUNTIME POLYMORPHISM: Calls Admin::displayMenu()
-        string choice;
-        getline(cin, choice);
+    while (inSession && !session.eof()) {
+        userPtr->displayMenu(out); // RUNTIME POLYMORPHISM: Calls Admin::displayMenu()
+        string choice = co_await session.readLine();
+        if (session.eof()) break;
 
         try {
             if (choice == "1") {
                 // Add Course
-                cout << "\n--- Add New Course ---\n";
-                string code = prompt("Course Code: ");
-                string title = prompt("Course Title: ");
-                int capacity;
-                cout << "Capacity: ";
-                cin >> capacity;
-                cin.ignore();
+                out << "\n--- Add New Course ---\n";
+                string code = co_await session.prompt("Course Code: ");
+                string title = co_await session.prompt("Course Title: ");
+                int capacity = InputValidator::parseInteger(co_await session.prompt("Capacity: "));
                 
-                string day = prompt("Day of Week (e.g., Monday): ");
-                string startTime = prompt("Start Time (HH:MM): ");
-                string endTime = prompt("End Time (HH:MM): ");
+                string meetings = co_await session.prompt("Meetings (e.g., Monday 09:00-10:30,Wednesday 09:00-10:30): ");
                 
-                Course newCourse(code, title, capacity, day, startTime, endTime);
+                if (!InputValidator::isValidCourseCode(code)) {
+                    throw InvalidInputException("course code", code, "expected 2-4 letters followed by 3 digits");
+                }
+                if (!InputValidator::isValidCapacity(capacity)) {
+                    throw InvalidInputException("capacity", to_string(capacity), "must be between 1 and 500");
+                }
+                if (!meetings.empty() && !InputValidator::isValidMeetingList(meetings)) {
+                    throw InvalidInputException("meetings", meetings, "expected 'Day HH:MM-HH:MM' entries that do not overlap");
+                }
                 
-                // Get mutable reference to courses
-                vector<Course> courses = regSys.getCourses();
-                admin.addCourse(courses, newCourse);
+                // First section is 001; more can be added via Modify Course
+                Course newCourse(code, title);
+                newCourse.addSection(Section("001", capacity, Section::parseMeetings(meetings)));
                 
-                // Note: In a real system, you'd need to update RegistrationSystem
-                // For now, this demonstrates the Admin functionality
+                admin.addCourse(regSys, newCourse, out);
                 
             } else if (choice == "2") {
                 // Remove Course
-                cout << "\n--- Remove Course ---\n";
-                string code = prompt("Enter course code to remove: ");
+                out << "\n--- Remove Course ---\n";
+                string code = co_await session.prompt("Enter course code to remove: ");
+                string alternative = co_await session.prompt("Offer enrolled students a seat in (course code, blank for none): ");
                 
-                vector<Course> courses = regSys.getCourses();
-                admin.removeCourse(courses, code);
+                admin.removeCourse(regSys, code, alternative, out);
                 
             } else if (choice == "3") {
                 // Modify Course
-                cout << "\n--- Modify Course ---\n";
-                string code = prompt("Enter course code to modify: ");
+                out << "\n--- Modify Course ---\n";
+                string code = co_await session.prompt("Enter course code to modify: ");
                 
-                vector<Course> courses = regSys.getCourses();
-                admin.modifyCourse(courses, code);
+                co_await admin.modifyCourse(session, regSys, code);
                 
             } else if (choice == "4") {
                 // View All Courses
-                admin.viewAllCourses(regSys.getCourses());
+                co_await admin.viewAllCourses(session, regSys);
                 
             } else if (choice == "5") {
                 // View Course Enrollments
-                string code = prompt("Enter course code: ");
-                admin.viewCourseEnrollments(regSys.getCourses(), code);
+                string code = co_await session.prompt("Enter course code: ");
+                co_await admin.viewCourseEnrollments(session, regSys, code);
                 
             } else if (choice == "6") {
                 // View All Students
-                admin.viewAllStudents(regSys.getStudents());
+                co_await admin.viewAllStudents(session, regSys);
                 
             } else if (choice == "7") {
                 // View My Info
-                admin.displayInfo();
+                admin.displayInfo(out);
                 
             } else if (choice == "8") {
                 inSession = false;
-                cout << "Logging out...\n";
+                out << "Logging out...\n";
+            } else if (choice == "9") {
+                // Open Seat Allocation Window
+                regSys.openAllocationWindow();
+                out << "\n✓ Allocation window opened. Student registrations are now collected as requests.\n";
+                
+            } else if (choice == "10") {
+                // Close Window and Allocate Seats
+                out << "\n--- Allocate Seats (" << regSys.pendingRequestCount() << " requests) ---\n";
+                out << "Priority policy: 1. GPA  2. Class Year  3. Lottery Only\n";
+                string policyChoice = co_await session.prompt("Choice: ");
+                string seedStr = co_await session.prompt("Random seed (blank for 1): ");
+                
+                AllocationPolicy policy;
+                if (policyChoice == "2") policy.priority = PriorityPolicy::ClassYear;
+                else if (policyChoice == "3") policy.priority = PriorityPolicy::LotteryOnly;
+                if (InputValidator::isValidPositiveInteger(seedStr)) policy.seed = stoull(seedStr);
+                
+                AllocationReport report;
+                {
+                    RegistrationSystem::ActorScope actor(regSys, admin.getUserID());
+                    report = regSys.closeAllocationWindow(policy);
+                }
+                report.print(out);
+                
+                string reportPath = co_await session.prompt("Save report to file (blank to skip): ");
+                if (!reportPath.empty()) {
+                    ofstream reportFile(reportPath);
+                    if (!reportFile.is_open()) {
+                        throw FileException(reportPath, "write");
+                    }
+                    report.print(reportFile);
+                    out << "✓ Report saved to " << reportPath << endl;
+                }
+                
+            } else if (choice == "11") {
+                // Enrollment Analytics
+                co_await admin.viewEnrollmentAnalytics(session, regSys);
+                
+            } else if (choice == "12") {
+                // Export Data
+                co_await admin.exportData(session, regSys);
+                
+            } else if (choice == "13") {
+                // Term Rollover
+                co_await admin.rolloverTerm(session, regSys);
+                
+            } else if (choice == "14") {
+                // View Past Term
+                co_await admin.viewPastTerm(session, regSys);
+                
+            } else if (choice == "15") {
+                // Edit Prerequisites
+                co_await admin.editPrerequisites(session, regSys);
+                
+            } else if (choice == "16") {
+                // Registration Rules
+                co_await admin.manageRules(session, regSys);
+                
+            } else if (choice == "17") {
+                // Enrollment History Log
+                co_await admin.viewEnrollmentLog(session, regSys);
+                
+            } else if (choice == "18") {
+                // Enroll a Cohort
+                co_await admin.enrollCohort(session, regSys);
             } else {
-                cout << "Invalid choice. Try again.\n";
+                out << "Invalid choice. Try again.\n";
             }
         } catch (const RegistrationException& e) {
-            cout << "Error: " << e.what() << endl;
+            out << "Error: " << e.what() << endl;
         } catch (const exception& e) {
-            cout << "Unexpected error: " << e.what() << endl;
+            out << "Unexpected error: " << e.what() << endl;
         }
     }
 }
 
-int main() {
-    // Initialize systems with file paths
-    RegistrationSystem regSys("data/students.txt", "data/courses.txt");
-    FileManager fileManager("data/admins.txt");
-    
-    // Load data from files
-    cout << "=== Loading System Data ===\n";
-    regSys.loadData();
-    vector<Admin> admins = fileManager.loadAdmins();
-    
-    // Create default admin if none exist
-    if (admins.empty()) {
-        cout << "\nNo admin accounts found. Creating default admin...\n";
-        Admin defaultAdmin("admin", "admin123", "admin@university.edu", "System Admin", "A001");
-        admins.push_back(defaultAdmin);
-        fileManager.saveAdmins(admins);
-        cout << "Default admin created (username: admin, password: admin123)\n";
-    }
-    
+// Top-level menu of one session; returns once the user exits
+static SessionTask<> mainMenu(Session& session, RegistrationSystem& regSys, AdmissionController& admission,
+                              FileManager& fileManager, vector<Admin>& admins) {
+    ostream& out = session.out();
     bool running = true;
 
     while (running) {
-        cout << "\n========================================\n";
-        cout << "  UNIVERSITY COURSE REGISTRATION       \n";
-        cout << "========================================\n";
-        cout << "1. Student Sign Up\n";
-        cout << "2. Student Login\n";
-        cout << "3. Admin Login\n";
-        cout << "4. Exit\n";
-        cout << "========================================\n";
-        cout << "Choose an option: ";
+        out << "\n========================================\n";
+        out << "  UNIVERSITY COURSE REGISTRATION       \n";
+        out << "========================================\n";
+        out << "1. Student Sign Up\n";
+        out << "2. Student Login\n";
+        out << "3. Admin Login\n";
+        out << "4. Exit\n";
+        out << "========================================\n";
+        out << "Choose an option: ";
 
-        string choice;
-        getline(cin, choice);
+        // End of input saves and exits like option 4
+        string choice = co_await session.readLine();
+        if (session.eof()) choice = "4";
 
         try {
             if (choice == "1") {
                 // Student Sign Up
-                cout << "\n--- Student Sign Up ---\n";
-                string username = prompt("Username: ");
-                string password = prompt("Password: ");
-                string email = prompt("Email: ");
-                string name = prompt("Full Name: ");
-                string studentID = prompt("Student ID: ");
-                string major = prompt("Major: ");
+                out << "\n--- Student Sign Up ---\n";
+                string username = co_await session.prompt("Username: ");
+                string password = co_await session.prompt("Password: ");
+                string email = co_await session.prompt("Email: ");
+                string name = co_await session.prompt("Full Name: ");
+                string studentID = co_await session.prompt("Student ID: ");
+                string major = co_await session.prompt("Major: ");
                 double gpa = 0.0;
+                string gpaStr = co_await session.prompt("GPA (0.0-4.0): ");
                 try {
-                    string gpaStr = prompt("GPA (0.0-4.0): ");
                     if (!gpaStr.empty()) {
                         gpa = stod(gpaStr);
                     }
@@ -250,43 +458,44 @@ int main() {
                     gpa = 0.0;
                 }
                 
-                string userID = "U" + to_string(regSys.getStudents().size() + 1);
+                string userID = "U" + to_string(regSys.getStudentCount() + 1);
                 
                 try {
                     Student& s = regSys.createStudent(username, password, email, name, 
                                                       userID, studentID, major, gpa);
                     regSys.saveData();  // Save immediately to file
                     
-                    cout << "\n✓ Student account created for " << s.getName() << "!\n";
-                    cout << "Username: " << username << endl;
-                    cout << "You can now log in.\n";
+                    out << "\n✓ Student account created for " << s.getName() << "!\n";
+                    out << "Username: " << username << endl;
+                    out << "You can now log in.\n";
                 } catch (const RegistrationException& e) {
-                    cout << "Signup failed: " << e.what() << endl;
+                    out << "Signup failed: " << e.what() << endl;
                 }
                 
             } else if (choice == "2") {
                 // Student Login
-                cout << "\n--- Student Login ---\n";
-                string username = prompt("Username: ");
-                string password = prompt("Password: ");
+                out << "\n--- Student Login ---\n";
+                string username = co_await session.prompt("Username: ");
+                string password = co_await session.prompt("Password: ");
                 
                 Student* s = regSys.login(username, password);
                 if (!s) {
-                    cout << "✗ Invalid username or password.\n";
-                    cout << "Debug: Username entered = '" << username << "'\n";
-                    cout << "Debug: Registered students count = " << regSys.getStudents().size() << "\n";
+                    out << "✗ Invalid username or password.\n";
+                    out << "Debug: Username entered = '" << username << "'\n";
+                    out << "Debug: Registered students count = " << regSys.getStudentCount() << "\n";
                 } else {
-                    cout << "\n✓ Welcome, " << s->getName() << "!\n";
-                    cout << "User Type: " << s->getUserType() << endl; // Polymorphism
-                    studentSession(*s, regSys);
+                    out << "\n✓ Welcome, " << s->getName() << "!\n";
+                    out << "User Type: " << s->getUserType() << endl; // Polymorphism
+                    co_await studentSession(session, *s, regSys, admission);
+                    regSys.logout(*s);
                     regSys.saveData(); // Save after session ends
                 }
                 
             } else if (choice == "3") {
                 // Admin Login
-                cout << "\n--- Admin Login ---\n";
-                string username = prompt("Username: ");
-                string password = prompt("Password: ");
+                out << "\n--- Admin Login ---\n";
+                string username = co_await session.prompt("Username: ");
+                string password = co_await session.prompt("Password: ");
                 
                 // Find admin
                 Admin* loggedInAdmin = nullptr;
@@ -298,30 +507,100 @@ int main() {
                 }
                 
                 if (!loggedInAdmin) {
-                    cout << "✗ Invalid admin credentials.\n";
+                    out << "✗ Invalid admin credentials.\n";
                 } else {
-                    cout << "\n✓ Welcome, Admin " << loggedInAdmin->getName() << "!\n";
-                    cout << "User Type: " << loggedInAdmin->getUserType() << endl; // Polymorphism
-                    adminSession(*loggedInAdmin, regSys);
+                    out << "\n✓ Welcome, Admin " << loggedInAdmin->getName() << "!\n";
+                    out << "User Type: " << loggedInAdmin->getUserType() << endl; // Polymorphism
+                    co_await adminSession(session, *loggedInAdmin, regSys);
                     regSys.saveData(); // Save changes made by admin
                     fileManager.saveAdmins(admins); // Save admin data
                 }
                 
             } else if (choice == "4") {
                 // Exit
-                cout << "\n=== Saving System Data ===\n";
+                out << "\n=== Saving System Data ===\n";
                 regSys.saveData();
                 fileManager.saveAdmins(admins);
-                cout << "All data saved. Goodbye!\n";
+                regSys.waitForExport();  // Let a running export finish writing
+                out << "All data saved. Goodbye!\n";
                 running = false;
             } else {
-                cout << "Invalid option. Try again.\n";
+                out << "Invalid option. Try again.\n";
             }
             
         } catch (const RegistrationException& e) {
-            cout << "Registration Error: " << e.what() << endl;
+            out << "Registration Error: " << e.what() << endl;
+        } catch (const exception& e) {
+            out << "Error: " << e.what() << endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Initialize systems with file paths
+    RegistrationSystem regSys("data/students.txt", "data/courses.txt");
+    FileManager fileManager("data/admins.txt");
+    
+    // Maintenance tool: "--reshard N" rewrites the data files into N shards and exits
+    if (argc == 3 && string(argv[1]) == "--reshard") {
+        try {
+            if (!InputValidator::isValidPositiveInteger(argv[2])) {
+                throw InvalidInputException("shard count", argv[2], "must be a positive integer");
+            }
+            regSys.loadData();
+            size_t oldCount = regSys.getShardCount();
+            regSys.reshard(stoul(argv[2]));
+            cout << "Resharded data from " << oldCount << " to " << regSys.getShardCount() << " shard(s).\n";
+            return 0;
         } catch (const exception& e) {
-            cout << "Error: " << e.what() << endl;
+            cout << "Reshard failed: " << e.what() << endl;
+            return 1;
+        }
+    }
+    
+    // "--lazy-students N": index student files at startup and keep at most N records loaded
+    if (argc == 3 && string(argv[1]) == "--lazy-students") {
+        if (!InputValidator::isValidPositiveInteger(argv[2])) {
+            cout << "Invalid cache size: " << argv[2] << endl;
+            return 1;
+        }
+        regSys.enableLazyStudents(stoul(argv[2]));
+    }
+    
+    // Load data from files
+    cout << "=== Loading System Data ===\n";
+    regSys.loadData();
+    vector<Admin> admins = fileManager.loadAdmins();
+    
+    // Create default admin if none exist
+    if (admins.empty()) {
+        cout << "\nNo admin accounts found. Creating default admin...\n";
+        Admin defaultAdmin("admin", "admin123", "admin@university.edu", "System Admin", "A001");
+        admins.push_back(defaultAdmin);
+        fileManager.saveAdmins(admins);
+        cout << "Default admin created (username: admin, password: admin123)\n";
+    }
+    
+    // The console is one session; its steps run on this thread between reads.
+    // Student register/drop/swap go through the admission controller, which
+    // runs them under the executor's engine lock.
+    SessionExecutor executor;
+    AdmissionController admission(regSys, executor.engineLock());
+    Session console(executor, [](const string& text) { cout << text << flush; });
+    console.start(mainMenu(console, regSys, admission, fileManager, admins));
+    
+    string line;
+    while (true) {
+        executor.runPending();
+        if (console.finished()) break;
+        if (!console.needsInput()) {
+            executor.waitForWork();   // Parked until its admitted request completes
+            continue;
+        }
+        if (getline(cin, line)) {
+            console.input(line);
+        } else {
+            console.close();
         }
     }
 
@@ -0,0 +1,110 @@
+// Steady-state allocation check for the register/drop/login path.
+//
+// Replaces the global operator new with a counting one, warms a
+// RegistrationSystem up, then repeats register -> drop -> login -> logout
+// and fails if any of those cycles touched the heap. Runs once with every
+// student resident and once in lazy mode.
+//
+// Deliberately exempt (done during the warm-up, not counted):
+//  - loading data, creating courses/students and the first registration
+//  - first-use growth of reusable buffers (roster and schedule vectors,
+//    the enrollment log's pending batch, scratch rows in the catalog view)
+//  - opening the enrollment log directory and its first segment file; a new
+//    segment is opened every EnrollmentLog::SEGMENT_EVENTS events, which the
+//    counted cycles never reach
+//  - filling the catalog publisher's spare versions, chunks and course
+//    copies; once warm, every counted register/drop publishes into them
+//
+// Build and run with tests/run_alloc_test.sh.
+
+#include "../include/RegistrationSystem.h"
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <string>
+
+namespace {
+
+std::atomic<long> allocations{0};
+std::atomic<bool> counting{false};
+
+const int WARMUP_CYCLES = 300;
+const int COUNTED_CYCLES = 1000;
+
+// Writes the catalog and one student, enrolled in ZZ200, into dir
+void prepare(const std::string& dir) {
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    RegistrationSystem reg(dir + "/students.txt", dir + "/courses.txt");
+    reg.loadData();
+    Course monday("ZZ100", "Allocation Test A");
+    monday.addSection(Section("001", 50, {Meeting("Monday", "09:00", "10:00")}));
+    reg.addCourse(monday);
+    Course tuesday("ZZ200", "Allocation Test B");
+    tuesday.addSection(Section("001", 50, {Meeting("Tuesday", "09:00", "10:00")}));
+    reg.addCourse(tuesday);
+    Student& student = reg.createStudent("alloctest", "pw", "alloc@test.edu", "Alloc Test",
+                                         "U9001", "S9001", "CS", 3.0);
+    reg.registerForCourse(student, "ZZ200");
+    reg.saveData();
+}
+
+// Allocations over the counted cycles, or -1 if a step failed
+long measure(const std::string& dir, bool lazy) {
+    prepare(dir);
+    RegistrationSystem reg(dir + "/students.txt", dir + "/courses.txt");
+    if (lazy) reg.enableLazyStudents(4);
+    reg.loadData();
+
+    bool ok = true;
+    auto cycle = [&]() {
+        Student* student = reg.login("alloctest", "pw");
+        if (!student) {
+            ok = false;
+            return;
+        }
+        ok = ok && reg.tryRegisterForCourse(*student, "ZZ100").ok();
+        ok = ok && reg.tryDropCourse(*student, "ZZ100").ok();
+        reg.logout(*student);
+    };
+
+    for (int i = 0; i < WARMUP_CYCLES; ++i) cycle();
+    allocations = 0;
+    counting = true;
+    for (int i = 0; i < COUNTED_CYCLES; ++i) cycle();
+    counting = false;
+
+    if (!ok) {
+        std::cerr << "register/drop/login failed during the test\n";
+        return -1;
+    }
+    return allocations.load();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char* argv[]) {
+    std::string dir = argc > 1 ? argv[1]
+                               : (std::filesystem::temp_directory_path() / "registration_alloc_test").string();
+    int failures = 0;
+    for (bool lazy : {false, true}) {
+        long count = measure(dir, lazy);
+        std::cout << (lazy ? "lazy:  " : "eager: ") << count << " allocation(s) in "
+                  << COUNTED_CYCLES << " register/drop/login cycles\n";
+        if (count != 0) ++failures;
+    }
+    std::filesystem::remove_all(dir);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,10 @@
+#!/bin/sh
+# Builds tests/alloc_test.cpp against the engine sources in src/ (the
+# console front end in main, Admin and FileManager is left out) and runs it.
+# Exits non-zero if the steady-state register/drop/login path allocates.
+set -e
+root=$(cd "$(dirname "$0")/.." && pwd)
+out=${TMPDIR:-/tmp}/registration_alloc_test
+sources=$(ls "$root"/src/*.cpp | grep -Ev '/(main|Admin|FileManager)\.cpp$')
+${CXX:-g++} -std=c++20 -O2 -pthread "$root/tests/alloc_test.cpp" $sources -o "$out"
+"$out"